@@ -0,0 +1,86 @@
+// Sensor query benchmark for CollisionTerrain.
+//
+//   g++ -std=c++17 -O2 -I. $(sdl2-config --cflags) bench/CollisionBench.cpp physics/CollisionTerrain.cpp core/Log.cpp -o collision_bench
+//
+// Builds a synthetic zone out of flat ground, slopes, half-height steps and walls with
+// AddTile/SetLayout, then runs floor, ceiling and wall sensors across the whole zone
+// the way a player and a few dozen objects would each frame.
+#include <physics/CollisionTerrain.hpp>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+static const int ZONE_WIDTH = 1024;     // tiles
+static const int ZONE_HEIGHT = 128;     // tiles
+static const int QUERY_COUNT = 4000000;
+
+static void BuildZone(CollisionTerrain& terrain) {
+    uint8_t heights[16];
+    for (int x = 0; x < 16; x++) heights[x] = 16;
+    uint16_t full = terrain.AddTile(heights, 0);
+    for (int x = 0; x < 16; x++) heights[x] = static_cast<uint8_t>(x + 1);
+    uint16_t slope = terrain.AddTile(heights, 224);
+    for (int x = 0; x < 16; x++) heights[x] = 8;
+    uint16_t step = terrain.AddTile(heights, 0);
+    for (int x = 0; x < 16; x++) heights[x] = x < 4 ? 16 : 0;
+    uint16_t wall = terrain.AddTile(heights, 64);
+
+    // Rolling ground with walls and hanging ceilings, deterministic so runs compare.
+    std::vector<uint16_t> cells(static_cast<size_t>(ZONE_WIDTH) * ZONE_HEIGHT, 0);
+    uint32_t seed = 12345;
+    int ground = ZONE_HEIGHT / 2;
+    for (int x = 0; x < ZONE_WIDTH; x++) {
+        seed = seed * 1664525u + 1013904223u;
+        int kind = (seed >> 16) % 8;
+        if (kind == 0 && ground > 8) ground--;
+        if (kind == 1 && ground < ZONE_HEIGHT - 8) ground++;
+
+        uint16_t surface = kind == 2 ? slope : kind == 3 ? static_cast<uint16_t>(slope | CollisionTerrain::FlipX) : kind == 4 ? step : full;
+        cells[static_cast<size_t>(ground) * ZONE_WIDTH + x] = surface;
+        for (int y = ground + 1; y < ZONE_HEIGHT; y++) cells[static_cast<size_t>(y) * ZONE_WIDTH + x] = full;
+        if (kind == 5) cells[static_cast<size_t>(ground - 1) * ZONE_WIDTH + x] = wall;
+        if (kind == 6) cells[static_cast<size_t>(ground - 4) * ZONE_WIDTH + x] = static_cast<uint16_t>(step | CollisionTerrain::FlipY);
+    }
+    terrain.SetLayout(ZONE_WIDTH, ZONE_HEIGHT, std::move(cells));
+}
+
+int main() {
+    CollisionTerrain terrain;
+    BuildZone(terrain);
+
+    // Sensor positions are precomputed so the loop only measures the casts.
+    std::vector<int> xs(QUERY_COUNT), ys(QUERY_COUNT);
+    uint32_t seed = 67890;
+    for (int i = 0; i < QUERY_COUNT; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        xs[i] = static_cast<int>(seed % static_cast<uint32_t>(terrain.GetWidth()));
+        seed = seed * 1664525u + 1013904223u;
+        ys[i] = static_cast<int>(seed % static_cast<uint32_t>(terrain.GetHeight()));
+    }
+
+    struct Sensor {
+        const char* name;
+        SensorResult (CollisionTerrain::*cast)(int, int) const;
+    };
+    const Sensor sensors[] = {
+        { "floor", &CollisionTerrain::CastFloor },
+        { "ceiling", &CollisionTerrain::CastCeiling },
+        { "wall right", &CollisionTerrain::CastWallRight },
+        { "wall left", &CollisionTerrain::CastWallLeft },
+    };
+
+    std::printf("%d queries per sensor on a %dx%d tile zone\n", QUERY_COUNT, ZONE_WIDTH, ZONE_HEIGHT);
+    for (const Sensor& sensor : sensors) {
+        long long checksum = 0;
+        int hits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < QUERY_COUNT; i++) {
+            SensorResult result = (terrain.*sensor.cast)(xs[i], ys[i]);
+            checksum += result.distance;
+            hits += result.hit;
+        }
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::printf("%-10s %8.2f ms  %6.1f ns/query  hits %d  checksum %lld\n", sensor.name, ms, ms * 1e6 / QUERY_COUNT, hits, checksum);
+    }
+    return 0;
+}
@@ -0,0 +1,103 @@
+// Scaling benchmark for JobSystem with 1, 2, 4 and 8 workers.
+//
+//   g++ -std=c++17 -O2 -pthread -I. bench/JobSystemBench.cpp core/JobSystem.cpp core/Log.cpp -o jobsystem_bench
+//
+// ParallelFor runs a per-object update over a large flat array, the same shape as
+// advancing animation states or culling entities. Small jobs measures queueing
+// overhead with many tiny independent jobs sharing one counter; the main thread deals
+// them across every worker's deque. Nested jobs submits the same work from inside
+// one job per worker, so each batch lands on a worker's own deque and the rest of the
+// pool has to steal it.
+#include <core/JobSystem.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <vector>
+
+struct BenchObject {
+    float x, y;
+    float velocityX, velocityY;
+    uint32_t tick;
+};
+
+static double TimeMs(const std::function<void()>& function, int repeats) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; i++) function();
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / repeats;
+}
+
+int main() {
+    const size_t objectCount = 1 << 20;
+    const int smallJobCount = 20000;
+    const unsigned int workerCounts[] = { 1, 2, 4, 8 };
+
+    std::vector<BenchObject> objects(objectCount);
+    for (size_t i = 0; i < objectCount; i++) {
+        objects[i] = { static_cast<float>(i), 0.0f, 1.5f, -0.5f, 0 };
+    }
+
+    double baseParallelFor = 0.0;
+    double baseSmallJobs = 0.0;
+    double baseNestedJobs = 0.0;
+    std::printf("%-8s %18s %8s %18s %8s %18s %8s\n", "workers", "parallel-for (ms)", "speedup",
+        "small jobs (ms)", "speedup", "nested jobs (ms)", "speedup");
+
+    for (unsigned int workers : workerCounts) {
+        JobSystem& jobs = JobSystem::GetInstance();
+        jobs.Initialize(workers);
+
+        double parallelFor = TimeMs([&]() {
+            jobs.ParallelFor(objects.size(), 0, [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    BenchObject& object = objects[i];
+                    object.x += object.velocityX;
+                    object.y += object.velocityY + std::sin(object.x * 0.01f);
+                    object.tick++;
+                }
+            });
+        }, 50);
+
+        std::vector<float> results(smallJobCount);
+        auto smallJob = [&results](int i) {
+            float value = 0.0f;
+            for (int k = 0; k < 200; k++) value += std::sqrt(static_cast<float>(i + k));
+            results[i] = value;
+        };
+        double smallJobs = TimeMs([&]() {
+            JobCounter counter;
+            for (int i = 0; i < smallJobCount; i++) {
+                jobs.Run([&smallJob, i]() { smallJob(i); }, &counter);
+            }
+            jobs.Wait(counter);
+        }, 20);
+
+        double nestedJobs = TimeMs([&]() {
+            JobCounter counter;
+            int batch = (smallJobCount + static_cast<int>(workers) - 1) / static_cast<int>(workers);
+            for (int first = 0; first < smallJobCount; first += batch) {
+                int last = std::min(smallJobCount, first + batch);
+                jobs.Run([&jobs, &smallJob, &counter, first, last]() {
+                    for (int i = first; i < last; i++) {
+                        jobs.Run([&smallJob, i]() { smallJob(i); }, &counter);
+                    }
+                }, &counter);
+            }
+            jobs.Wait(counter);
+        }, 20);
+
+        if (workers == 1) {
+            baseParallelFor = parallelFor;
+            baseSmallJobs = smallJobs;
+            baseNestedJobs = nestedJobs;
+        }
+        std::printf("%-8u %18.3f %7.2fx %18.3f %7.2fx %18.3f %7.2fx\n", workers,
+            parallelFor, baseParallelFor / parallelFor, smallJobs, baseSmallJobs / smallJobs,
+            nestedJobs, baseNestedJobs / nestedJobs);
+
+        jobs.Shutdown();
+    }
+    return 0;
+}
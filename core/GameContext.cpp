@@ -5,18 +5,38 @@
 #include <states/TitleGameState.hpp>
 #include <states/GameplayState.hpp>
 #include <input/InputManager.hpp>
-#include <iostream>
+#include <graphics/AnimationManager.hpp>
+#include "Log.hpp"
+#include "Metrics.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <algorithm>
 #include <SDL2/SDL.h>
 
 const int TARGET_FPS = 60;
 const int FRAME_DELAY = 1000 / TARGET_FPS;
 
+// A snapshot every 4 frames, 10 seconds of rewind, a full keyframe every second.
+const int SNAPSHOT_INTERVAL = 4;
+const size_t REWIND_CAPACITY = 150;
+const size_t REWIND_KEYFRAME_INTERVAL = 15;
+const size_t REWIND_STEP = 15;
+static const char* const QUICKSAVE_PATH = "quicksave.yus";
+const int METRICS_INTERVAL_MS = 5000;
+
+static const uint32_t ContextChunkTag = MakeSnapshotTag('C', 'T', 'X', ' ');
+static const uint16_t ContextChunkVersion = 1;
+
 GameContext::GameContext() 
     : window_(nullptr)
     , renderer_(nullptr)
     , isRunning_(false)
     , isFullscreen_(true)
+    , debugHotkeys_(false)
     , currentState_(std::make_unique<DisclaimerGameState>(this))
+    , frameCount_(0)
+    , rewindBuffer_(REWIND_CAPACITY, REWIND_KEYFRAME_INTERVAL)
+    , publishedState_(nullptr)
 {
 }
 
@@ -25,30 +45,53 @@ GameContext::~GameContext() {
 }
 
 bool GameContext::Initialize() {
+    // Soak runs set these to get quieter logs and a periodic metrics dump.
+    if (const char* level = std::getenv("YU2_LOG_LEVEL")) {
+        LogLevel parsed;
+        if (Log::ParseLevel(level, parsed)) Log::SetLevel(parsed);
+    }
+    if (const char* metricsPath = std::getenv("YU2_METRICS_FILE")) {
+        Metrics::GetInstance().StartDump(metricsPath, METRICS_INTERVAL_MS);
+    }
+    // Quicksave, quickload and rewind hotkeys are for testing only.
+#ifndef NDEBUG
+    debugHotkeys_ = true;
+#endif
+    if (const char* hotkeys = std::getenv("YU2_DEBUG_HOTKEYS")) {
+        debugHotkeys_ = std::atoi(hotkeys) != 0;
+    }
+
     if (!InitializeSDL()) {
-        std::cerr << "Failed to initialize SDL" << std::endl;
+        LOG_ERROR("Failed to initialize SDL");
         return false;
     }
 
+    InputManager::LoadBindings(inputConfigPath_);
+
     if (!CreateWindow()) {
-        std::cerr << "Failed to create window" << std::endl;
+        LOG_ERROR("Failed to create window");
         return false;
     }
 
     if (!CreateRenderer()) {
-        std::cerr << "Failed to create renderer" << std::endl;
+        LOG_ERROR("Failed to create renderer");
+        return false;
+    }
+
+    if (!GetJobSystem().Initialize()) {
+        LOG_ERROR("Failed to initialize job system");
         return false;
     }
 
     GetResourceManager().SetRenderer(renderer_);
 
     if (!InitializeResources()) {
-        std::cerr << "Failed to initialize resources" << std::endl;
+        LOG_ERROR("Failed to initialize resources");
         return false;
     }
 
     if (!currentState_->Initialize()) {
-        std::cerr << "Failed to initialize game state" << std::endl;
+        LOG_ERROR("Failed to initialize game state");
         return false;
     }
 
@@ -57,8 +100,8 @@ bool GameContext::Initialize() {
 }
 
 bool GameContext::InitializeSDL() {
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0) {
-        std::cerr << "SDL could not initialize! SDL_Error: " << SDL_GetError() << std::endl;
+    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO | SDL_INIT_GAMECONTROLLER) < 0) {
+        LOG_ERROR("SDL could not initialize! SDL_Error: " << SDL_GetError());
         return false;
     }
     return true;
@@ -75,7 +118,7 @@ bool GameContext::CreateWindow() {
     );
 
     if (window_ == nullptr) {
-        std::cerr << "Window could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+        LOG_ERROR("Window could not be created! SDL_Error: " << SDL_GetError());
         return false;
     }
 
@@ -88,7 +131,7 @@ bool GameContext::CreateWindow() {
 bool GameContext::CreateRenderer() {
     renderer_ = SDL_CreateRenderer(window_, -1, SDL_RENDERER_ACCELERATED);
     if (renderer_ == nullptr) {
-        std::cerr << "Renderer could not be created! SDL_Error: " << SDL_GetError() << std::endl;
+        LOG_ERROR("Renderer could not be created! SDL_Error: " << SDL_GetError());
         return false;
     }
     return true;
@@ -111,18 +154,42 @@ void GameContext::SetFullscreen(bool fullscreen) {
 }
 
 void GameContext::Run() {
+    Metrics& metrics = Metrics::GetInstance();
+    Counter& frames = metrics.GetCounter("frame.count");
+    Counter& overruns = metrics.GetCounter("frame.overruns");
+    Histogram& frameMs = metrics.GetHistogram("frame.work_ms", { 1, 2, 4, 8, 12, 16, 20, 33, 50, 100 });
+    Histogram& updateMs = metrics.GetHistogram("frame.update_ms", { 0.5, 1, 2, 4, 8, 16, 33 });
+    Histogram& renderMs = metrics.GetHistogram("frame.render_ms", { 0.5, 1, 2, 4, 8, 16, 33 });
+    Histogram& pipelineMs = metrics.GetHistogram("frame.pipeline_ms", { 0.5, 1, 2, 4, 8, 16, 33 });
+
     Uint32 frameStart;
     int frameTime;
     while (isRunning_) {
         frameStart = SDL_GetTicks();
-
-        HandleEvents();
-        Update();
-        Render();
+        {
+            ScopedTimer frameTimer(frameMs);
+            HandleEvents();
+            if (auto* frameJobs = dynamic_cast<FrameJobs*>(currentState_.get())) {
+                ScopedTimer pipelineTimer(pipelineMs);
+                RunFrameJobs(*frameJobs);
+            } else {
+                {
+                    ScopedTimer updateTimer(updateMs);
+                    Update();
+                }
+                {
+                    ScopedTimer renderTimer(renderMs);
+                    Render();
+                }
+            }
+        }
+        frames.Add();
 
         frameTime = SDL_GetTicks() - frameStart;
         if (FRAME_DELAY > frameTime) {
             SDL_Delay(FRAME_DELAY - frameTime);
+        } else {
+            overruns.Add();
         }
     }
 }
@@ -137,16 +204,66 @@ void GameContext::HandleEvents() {
             case SDL_KEYDOWN:
                 if (event.key.keysym.sym == SDLK_F11) {
                     SetFullscreen(!isFullscreen_);
+                } else if (debugHotkeys_) {
+                    if (event.key.keysym.sym == SDLK_F5) {
+                        SaveSnapshotToFile(QUICKSAVE_PATH);
+                    } else if (event.key.keysym.sym == SDLK_F8) {
+                        LoadSnapshotFromFile(QUICKSAVE_PATH);
+                    } else if (event.key.keysym.sym == SDLK_F6) {
+                        Rewind(REWIND_STEP);
+                    }
                 }
                 break;
+            case SDL_CONTROLLERDEVICEADDED:
+            case SDL_CONTROLLERDEVICEREMOVED:
+                InputManager::HandleEvent(event);
+                break;
         }
     }
 }
 
 void GameContext::Update() {
-    InputManager::UpdateKeyStates();
+    BeginUpdate();
     currentState_->Update();
+    FinishUpdate();
+}
 
+void GameContext::BeginUpdate() {
+    InputManager::UpdateKeyStates();
+    AnimationManager::GetInstance().Tick();
+}
+
+// Renders frame N while frame N+1 is simulated. Both are submitted as jobs; the main
+// thread waits only for the render jobs, issues the SDL calls, then waits for the update.
+void GameContext::RunFrameJobs(FrameJobs& state) {
+    static Histogram& renderMs = Metrics::GetInstance().GetHistogram("frame.render_ms", { 0.5, 1, 2, 4, 8, 16, 33 });
+
+    // A state that just became current has nothing published yet.
+    if (publishedState_ != currentState_.get()) {
+        state.PublishRenderState();
+        publishedState_ = currentState_.get();
+    }
+
+    BeginUpdate();
+
+    JobSystem& jobs = GetJobSystem();
+    JobCounter renderJobs;
+    JobCounter updateJobs;
+    jobs.Run([&]() { state.SubmitRenderJobs(jobs, renderJobs); }, &renderJobs);
+    jobs.Run([&]() { state.SubmitUpdateJobs(jobs, updateJobs); }, &updateJobs);
+
+    jobs.Wait(renderJobs);
+    {
+        ScopedTimer renderTimer(renderMs);
+        Render();
+    }
+    jobs.Wait(updateJobs);
+    state.PublishRenderState();
+
+    FinishUpdate();
+}
+
+void GameContext::FinishUpdate() {
     if (dynamic_cast<DisclaimerGameState*>(currentState_.get())) {
         auto* disclaimer = static_cast<DisclaimerGameState*>(currentState_.get());
         if (disclaimer->IsFinished()) {
@@ -175,6 +292,128 @@ void GameContext::Update() {
             currentState_->Initialize();
         }
     }
+
+    // Only F6 reads the rewind ring, so builds without the debug hotkeys skip filling it.
+    if (++frameCount_ % SNAPSHOT_INTERVAL == 0 && debugHotkeys_) {
+        SnapshotWriter writer;
+        SaveSnapshot(writer);
+        rewindBuffer_.Push(writer.GetData());
+    }
+}
+
+GameContext::StateId GameContext::GetStateId() const {
+    GameState* state = currentState_.get();
+    if (dynamic_cast<LogosGameState*>(state)) return STATE_LOGOS;
+    if (dynamic_cast<TeamLogoGameState*>(state)) return STATE_TEAM_LOGO;
+    if (dynamic_cast<TitleGameState*>(state)) return STATE_TITLE;
+    if (dynamic_cast<GameplayState*>(state)) return STATE_GAMEPLAY;
+    return STATE_DISCLAIMER;
+}
+
+std::unique_ptr<GameState> GameContext::CreateState(StateId id) {
+    switch (id) {
+        case STATE_LOGOS: return std::make_unique<LogosGameState>(this);
+        case STATE_TEAM_LOGO: return std::make_unique<TeamLogoGameState>(this);
+        case STATE_TITLE: return std::make_unique<TitleGameState>(this);
+        case STATE_GAMEPLAY: return std::make_unique<GameplayState>(this);
+        default: return std::make_unique<DisclaimerGameState>(this);
+    }
+}
+
+void GameContext::SaveSnapshot(SnapshotWriter& writer) const {
+    writer.BeginChunk(ContextChunkTag, ContextChunkVersion);
+    writer.Write(static_cast<uint8_t>(GetStateId()));
+    writer.Write(frameCount_);
+    writer.Write(AnimationManager::GetInstance().GetClock());
+    writer.EndChunk();
+
+    InputManager::SaveState(writer);
+
+    if (auto* state = dynamic_cast<const Snapshottable*>(currentState_.get())) {
+        state->SaveState(writer);
+    }
+}
+
+bool GameContext::LoadSnapshot(const std::vector<uint8_t>& snapshot) {
+    SnapshotReader reader(snapshot);
+    uint16_t version = 0;
+    if (!reader.IsValid() || !reader.BeginChunk(ContextChunkTag, version) || version != ContextChunkVersion) {
+        LOG_ERROR("Snapshot has no usable context chunk");
+        return false;
+    }
+
+    uint8_t stateId = 0;
+    uint32_t frameCount = 0;
+    uint32_t animationClock = 0;
+    if (!reader.Read(stateId) || !reader.Read(frameCount) || !reader.Read(animationClock) || stateId > STATE_GAMEPLAY) {
+        LOG_ERROR("Snapshot context chunk is corrupt");
+        return false;
+    }
+    reader.EndChunk();
+
+    if (static_cast<StateId>(stateId) != GetStateId()) {
+        auto state = CreateState(static_cast<StateId>(stateId));
+        if (!state->Initialize()) {
+            LOG_ERROR("Failed to initialize game state from snapshot");
+            return false;
+        }
+        currentState_ = std::move(state);
+    }
+    publishedState_ = nullptr;
+
+    frameCount_ = frameCount;
+    AnimationManager::GetInstance().SetClock(animationClock);
+
+    if (!InputManager::LoadState(reader)) {
+        LOG_ERROR("Snapshot input state is missing or corrupt");
+    }
+
+    if (auto* state = dynamic_cast<Snapshottable*>(currentState_.get())) {
+        if (!state->LoadState(reader)) {
+            LOG_ERROR("Failed to restore game state from snapshot");
+            return false;
+        }
+    }
+    return true;
+}
+
+bool GameContext::SaveSnapshotToFile(const std::string& path) const {
+    SnapshotWriter writer;
+    SaveSnapshot(writer);
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("Unable to write snapshot " << path << "!");
+        return false;
+    }
+    const auto& data = writer.GetData();
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return file.good();
+}
+
+bool GameContext::LoadSnapshotFromFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        LOG_ERROR("Unable to open snapshot " << path << "!");
+        return false;
+    }
+
+    std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), data.size());
+    if (!LoadSnapshot(data)) return false;
+
+    // Rewinding past a loaded snapshot would mix two timelines.
+    rewindBuffer_.Clear();
+    return true;
+}
+
+bool GameContext::Rewind(size_t steps) {
+    if (rewindBuffer_.GetCount() == 0) return false;
+    steps = std::min(steps, rewindBuffer_.GetCount() - 1);
+
+    std::vector<uint8_t> snapshot;
+    return rewindBuffer_.Rewind(steps, snapshot) && LoadSnapshot(snapshot);
 }
 
 void GameContext::Render() {
@@ -185,6 +424,12 @@ void GameContext::Render() {
 }
 
 void GameContext::Shutdown() {
+    Metrics::GetInstance().StopDump();
+    GetJobSystem().Shutdown();
+    AnimationManager::GetInstance().Shutdown();
+    InputManager::Shutdown();
+    GetResourceManager().Shutdown();
+
     if (renderer_) {
         SDL_DestroyRenderer(renderer_);
         renderer_ = nullptr;
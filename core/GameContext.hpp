@@ -4,6 +4,8 @@
 #include <memory>
 #include <string>
 #include "../resources/ResourceManager.hpp"
+#include "JobSystem.hpp"
+#include "Snapshot.hpp"
 #include <states/GameState.hpp>
 
 class GameContext {
@@ -20,10 +22,17 @@ public:
     int GetScreenWidth() const { return screenWidth_; }
     int GetScreenHeight() const { return screenHeight_; }
     ResourceManager& GetResourceManager() { return ResourceManager::GetInstance(); }
+    JobSystem& GetJobSystem() { return JobSystem::GetInstance(); }
 
     void SetFullscreen(bool fullscreen);
     bool IsFullscreen() const { return isFullscreen_; }
 
+    void SaveSnapshot(SnapshotWriter& writer) const;
+    bool LoadSnapshot(const std::vector<uint8_t>& snapshot);
+    bool SaveSnapshotToFile(const std::string& path) const;
+    bool LoadSnapshotFromFile(const std::string& path);
+    bool Rewind(size_t steps);
+
 private:
     bool InitializeSDL();
     bool CreateWindow();
@@ -31,17 +40,35 @@ private:
     bool InitializeResources();
     void HandleEvents();
     void Update();
+    void BeginUpdate();
+    void FinishUpdate();
+    void RunFrameJobs(FrameJobs& state);
     void Render();
 
+    enum StateId : uint8_t {
+        STATE_DISCLAIMER,
+        STATE_LOGOS,
+        STATE_TEAM_LOGO,
+        STATE_TITLE,
+        STATE_GAMEPLAY
+    };
+    StateId GetStateId() const;
+    std::unique_ptr<GameState> CreateState(StateId id);
+
     SDL_Window* window_;
     SDL_Renderer* renderer_;
     bool isRunning_;
     bool isFullscreen_;
+    bool debugHotkeys_;     // F5 quicksave, F8 quickload, F6 rewind
     
     const int screenWidth_ = 1280;
     const int screenHeight_ = 720;
     const std::string windowTitle_ = "Sonic 2 RE:HD - A w.i.p. Sonic 2 HD C++ remake";
     const std::string dataPath_ = "data/SONICORCA";
+    const std::string inputConfigPath_ = "input.json";
 
     std::unique_ptr<GameState> currentState_;
+    uint32_t frameCount_;
+    SnapshotRing rewindBuffer_;
+    GameState* publishedState_;     // last FrameJobs state whose render state was published
 }; 
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "JobSystem.hpp"
+#include <algorithm>
+#include "Log.hpp"
+
+static thread_local unsigned int currentWorker = 0;
+
+JobSystem& JobSystem::GetInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+JobSystem::~JobSystem() {
+    Shutdown();
+}
+
+bool JobSystem::Initialize(unsigned int workerCount) {
+    if (running_) return true;
+
+    if (workerCount == 0) {
+        workerCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    for (unsigned int i = 0; i < workerCount; i++) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    running_ = true;
+    currentWorker = 0;
+    try {
+        for (unsigned int i = 1; i < workerCount; i++) {
+            threads_.emplace_back(&JobSystem::WorkerLoop, this, i);
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("Failed to start job worker threads: " << e.what());
+        Shutdown();
+        return false;
+    }
+
+    return true;
+}
+
+void JobSystem::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        running_ = false;
+    }
+    wakeCondition_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) thread.join();
+    }
+    threads_.clear();
+
+    // Drain anything still queued so counters never stay non-zero.
+    for (unsigned int i = 0; i < queues_.size(); i++) {
+        Job job;
+        while (PopJob(i, job)) Execute(job);
+    }
+    queues_.clear();
+    pendingJobs_ = 0;
+    nextQueue_ = 0;
+}
+
+void JobSystem::Run(JobFunction job, JobCounter* counter) {
+    if (counter) counter->value_.fetch_add(1, std::memory_order_relaxed);
+
+    if (threads_.empty()) {
+        Job inlineJob{std::move(job), counter};
+        Execute(inlineJob);
+        return;
+    }
+
+    // The main thread submits nearly every job, so its jobs are dealt round-robin across
+    // all queues instead of piling up behind one lock. Workers keep theirs local.
+    unsigned int worker = currentWorker < queues_.size() ? currentWorker : 0;
+    if (worker == 0) {
+        worker = nextQueue_.fetch_add(1, std::memory_order_relaxed) % static_cast<unsigned int>(queues_.size());
+    }
+    pendingJobs_.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(queues_[worker]->mutex);
+        queues_[worker]->jobs.push_back(Job{std::move(job), counter});
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+    }
+    wakeCondition_.notify_one();
+}
+
+void JobSystem::Wait(JobCounter& counter) {
+    unsigned int worker = currentWorker < queues_.size() ? currentWorker : 0;
+    while (!counter.IsDone()) {
+        if (!TryRunJob(worker)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const RangeFunction& function) {
+    if (count == 0) return;
+    if (grainSize == 0) {
+        size_t workers = std::max<size_t>(1, queues_.size());
+        grainSize = std::max<size_t>(1, count / (workers * 4));
+    }
+
+    JobCounter counter;
+    for (size_t begin = grainSize; begin < count; begin += grainSize) {
+        size_t end = std::min(count, begin + grainSize);
+        Run([&function, begin, end]() { function(begin, end); }, &counter);
+    }
+    function(0, std::min(count, grainSize));
+    Wait(counter);
+}
+
+bool JobSystem::PopJob(unsigned int worker, Job& job) {
+    WorkerQueue& queue = *queues_[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty()) return false;
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    return true;
+}
+
+bool JobSystem::StealJob(unsigned int worker, Job& job) {
+    size_t count = queues_.size();
+    for (size_t i = 1; i < count; i++) {
+        WorkerQueue& queue = *queues_[(worker + i) % count];
+        std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+        if (!lock.owns_lock() || queue.jobs.empty()) continue;
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::TryRunJob(unsigned int worker) {
+    if (queues_.empty()) return false;
+    Job job;
+    if (!PopJob(worker, job) && !StealJob(worker, job)) {
+        return false;
+    }
+    pendingJobs_.fetch_sub(1, std::memory_order_relaxed);
+    Execute(job);
+    return true;
+}
+
+void JobSystem::Execute(Job& job) {
+    job.function();
+    if (job.counter) job.counter->value_.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::WorkerLoop(unsigned int worker) {
+    currentWorker = worker;
+    while (running_) {
+        if (TryRunJob(worker)) continue;
+
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        wakeCondition_.wait(lock, [this]() {
+            return !running_ || pendingJobs_.load(std::memory_order_relaxed) > 0;
+        });
+    }
+}
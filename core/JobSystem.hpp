@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobCounter {
+public:
+    JobCounter() : value_(0) {}
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool IsDone() const { return value_.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> value_;
+};
+
+class JobSystem {
+public:
+    using JobFunction = std::function<void()>;
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    static JobSystem& GetInstance();
+
+    // workerCount includes the calling (main) thread; 0 picks one per hardware thread.
+    bool Initialize(unsigned int workerCount = 0);
+    void Shutdown();
+
+    unsigned int GetWorkerCount() const { return static_cast<unsigned int>(queues_.size()); }
+
+    // Queues a job for the worker threads. Jobs queued from a worker go on its own deque;
+    // jobs from the main thread are spread over all deques. If a counter is given it is
+    // incremented now and decremented once the job has run, so several jobs can share
+    // one counter. Without worker threads (one worker, or before Initialize) the job runs inline
+    // before Run returns, so fire-and-forget jobs never wait for a Wait() call.
+    void Run(JobFunction job, JobCounter* counter = nullptr);
+
+    // Runs queued jobs on the calling thread until the counter reaches zero.
+    void Wait(JobCounter& counter);
+
+    void ParallelFor(size_t count, size_t grainSize, const RangeFunction& function);
+
+private:
+    struct Job {
+        JobFunction function;
+        JobCounter* counter = nullptr;
+    };
+
+    // Owner pushes and pops at the back, thieves take from the front.
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    JobSystem() = default;
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    bool PopJob(unsigned int worker, Job& job);
+    bool StealJob(unsigned int worker, Job& job);
+    bool TryRunJob(unsigned int worker);
+    void Execute(Job& job);
+    void WorkerLoop(unsigned int worker);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
+    std::atomic<bool> running_{false};
+    std::atomic<int> pendingJobs_{0};
+    std::atomic<unsigned int> nextQueue_{0};
+};
+
+// Implemented by game states that split their frame into jobs. GameContext submits the
+// render jobs for the frame last published and the update jobs for the next frame at
+// the same time, then draws with the state's Render() on the main thread while the
+// update is still running. The two sets of jobs must not share mutable data and must
+// not call SDL: PublishRenderState, called on the main thread once the update jobs
+// have finished, is where a state copies out what its render jobs read.
+class FrameJobs {
+public:
+    virtual ~FrameJobs() = default;
+    // Replaces GameState::Update for these states: entity updates, animation, culling.
+    virtual void SubmitUpdateJobs(JobSystem& jobs, JobCounter& counter) = 0;
+    // Builds draw commands from the published render state for Render() to issue.
+    virtual void SubmitRenderJobs(JobSystem& jobs, JobCounter& counter) = 0;
+    virtual void PublishRenderState() = 0;
+};
@@ -0,0 +1,35 @@
+#include "Log.hpp"
+#include <iostream>
+#include <mutex>
+
+std::atomic<int> Log::level_{static_cast<int>(LogLevel::Info)};
+
+static std::mutex logMutex;
+
+bool Log::ParseLevel(const std::string& name, LogLevel& level) {
+    if (name == "debug") level = LogLevel::Debug;
+    else if (name == "info") level = LogLevel::Info;
+    else if (name == "warning") level = LogLevel::Warning;
+    else if (name == "error") level = LogLevel::Error;
+    else if (name == "none") level = LogLevel::None;
+    else return false;
+    return true;
+}
+
+void Log::Write(LogLevel level, const std::string& message) {
+    std::lock_guard<std::mutex> lock(logMutex);
+    switch (level) {
+        case LogLevel::Debug:
+            std::cout << "[debug] " << message << std::endl;
+            break;
+        case LogLevel::Info:
+            std::cout << message << std::endl;
+            break;
+        case LogLevel::Warning:
+            std::cerr << "[warning] " << message << std::endl;
+            break;
+        default:
+            std::cerr << "[error] " << message << std::endl;
+            break;
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <atomic>
+#include <sstream>
+#include <string>
+
+enum class LogLevel : int {
+    Debug,
+    Info,
+    Warning,
+    Error,
+    None
+};
+
+// Messages below YU2_LOG_MIN_LEVEL are compiled out entirely; the rest cost one
+// relaxed load when filtered at runtime, since the message is only built if enabled.
+#ifndef YU2_LOG_MIN_LEVEL
+#define YU2_LOG_MIN_LEVEL 0
+#endif
+
+class Log {
+public:
+    static void SetLevel(LogLevel level) { level_.store(static_cast<int>(level), std::memory_order_relaxed); }
+    static LogLevel GetLevel() { return static_cast<LogLevel>(level_.load(std::memory_order_relaxed)); }
+    static bool IsEnabled(LogLevel level) {
+        return static_cast<int>(level) >= YU2_LOG_MIN_LEVEL &&
+               static_cast<int>(level) >= level_.load(std::memory_order_relaxed);
+    }
+    static bool ParseLevel(const std::string& name, LogLevel& level);
+
+    static void Write(LogLevel level, const std::string& message);
+
+private:
+    static std::atomic<int> level_;
+};
+
+#define YU2_LOG(level, message) \
+    do { \
+        if (Log::IsEnabled(level)) { \
+            std::ostringstream yu2LogStream; \
+            yu2LogStream << message; \
+            Log::Write(level, yu2LogStream.str()); \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(message) YU2_LOG(LogLevel::Debug, message)
+#define LOG_INFO(message) YU2_LOG(LogLevel::Info, message)
+#define LOG_WARNING(message) YU2_LOG(LogLevel::Warning, message)
+#define LOG_ERROR(message) YU2_LOG(LogLevel::Error, message)
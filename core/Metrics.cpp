@@ -0,0 +1,114 @@
+#include "Metrics.hpp"
+#include "Log.hpp"
+#include <algorithm>
+#include <fstream>
+#include <nlohmann/json.hpp>
+
+Histogram::Histogram(std::initializer_list<double> bounds)
+    : bounds_{}, bucketCount_(std::min(bounds.size(), MaxBuckets)) {
+    std::copy_n(bounds.begin(), bucketCount_, bounds_.begin());
+    for (auto& bucket : buckets_) bucket.store(0, std::memory_order_relaxed);
+}
+
+void Histogram::Observe(double value) {
+    size_t bucket = 0;
+    while (bucket < bucketCount_ && value > bounds_[bucket]) bucket++;
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+
+    double sum = sum_.load(std::memory_order_relaxed);
+    while (!sum_.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {}
+}
+
+Metrics& Metrics::GetInstance() {
+    static Metrics instance;
+    return instance;
+}
+
+Metrics::~Metrics() {
+    StopDump();
+}
+
+Counter& Metrics::GetCounter(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& counter = counters_[name];
+    if (!counter) counter = std::make_unique<Counter>();
+    return *counter;
+}
+
+Gauge& Metrics::GetGauge(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& gauge = gauges_[name];
+    if (!gauge) gauge = std::make_unique<Gauge>();
+    return *gauge;
+}
+
+Histogram& Metrics::GetHistogram(const std::string& name, std::initializer_list<double> bounds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& histogram = histograms_[name];
+    if (!histogram) histogram = std::make_unique<Histogram>(bounds);
+    return *histogram;
+}
+
+std::string Metrics::Snapshot() const {
+    nlohmann::json snapshot;
+    snapshot["uptime_ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime_).count();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& pair : counters_) {
+        snapshot["counters"][pair.first] = pair.second->Get();
+    }
+    for (const auto& pair : gauges_) {
+        snapshot["gauges"][pair.first] = pair.second->Get();
+    }
+    for (const auto& pair : histograms_) {
+        const Histogram& histogram = *pair.second;
+        nlohmann::json entry;
+        entry["count"] = histogram.GetCount();
+        entry["sum"] = histogram.GetSum();
+        for (size_t i = 0; i < histogram.GetBucketCount(); i++) {
+            entry["buckets"].push_back({ histogram.GetBound(i), histogram.GetBucket(i) });
+        }
+        entry["buckets"].push_back({ "inf", histogram.GetBucket(histogram.GetBucketCount()) });
+        snapshot["histograms"][pair.first] = entry;
+    }
+    return snapshot.dump();
+}
+
+bool Metrics::StartDump(const std::string& path, int intervalMs) {
+    StopDump();
+
+    std::ofstream file(path, std::ios::app);
+    if (!file.is_open()) {
+        LOG_ERROR("Unable to open metrics file " << path << "!");
+        return false;
+    }
+
+    startTime_ = std::chrono::steady_clock::now();
+    dumping_ = true;
+    dumpThread_ = std::thread(&Metrics::DumpLoop, this, path, std::max(1, intervalMs));
+    LOG_INFO("Writing metrics to " << path << " every " << intervalMs << "ms");
+    return true;
+}
+
+void Metrics::StopDump() {
+    {
+        std::lock_guard<std::mutex> lock(dumpMutex_);
+        dumping_ = false;
+    }
+    dumpCondition_.notify_all();
+    if (dumpThread_.joinable()) dumpThread_.join();
+}
+
+void Metrics::DumpLoop(std::string path, int intervalMs) {
+    std::ofstream file(path, std::ios::app);
+    std::unique_lock<std::mutex> lock(dumpMutex_);
+    bool running = true;
+    while (running) {
+        running = !dumpCondition_.wait_for(lock, std::chrono::milliseconds(intervalMs), [this]() { return !dumping_; });
+        // One last line on shutdown so short runs still leave numbers behind.
+        file << Snapshot() << '\n';
+        file.flush();
+    }
+}
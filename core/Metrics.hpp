@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class Counter {
+public:
+    void Add(int64_t value = 1) { value_.fetch_add(value, std::memory_order_relaxed); }
+    int64_t Get() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> value_{0};
+};
+
+class Gauge {
+public:
+    void Set(int64_t value) { value_.store(value, std::memory_order_relaxed); }
+    void Add(int64_t value) { value_.fetch_add(value, std::memory_order_relaxed); }
+    int64_t Get() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> value_{0};
+};
+
+// Bucket i counts observations <= bounds[i]; the last bucket catches everything above.
+class Histogram {
+public:
+    static constexpr size_t MaxBuckets = 16;
+
+    explicit Histogram(std::initializer_list<double> bounds);
+
+    void Observe(double value);
+
+    size_t GetBucketCount() const { return bucketCount_; }
+    double GetBound(size_t bucket) const { return bounds_[bucket]; }
+    uint64_t GetBucket(size_t bucket) const { return buckets_[bucket].load(std::memory_order_relaxed); }
+    uint64_t GetCount() const { return count_.load(std::memory_order_relaxed); }
+    double GetSum() const { return sum_.load(std::memory_order_relaxed); }
+
+private:
+    std::array<double, MaxBuckets> bounds_;
+    std::array<std::atomic<uint64_t>, MaxBuckets + 1> buckets_;
+    size_t bucketCount_;
+    std::atomic<uint64_t> count_{0};
+    std::atomic<double> sum_{0.0};
+};
+
+// Records the lifetime of the timer, in milliseconds, into a histogram.
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& histogram)
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start_;
+        histogram_.Observe(elapsed.count());
+    }
+
+private:
+    Histogram& histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Metrics are registered by name once and never removed, so callers can keep the
+// returned reference (typically in a function-local static) and update it lock-free.
+class Metrics {
+public:
+    static Metrics& GetInstance();
+
+    Counter& GetCounter(const std::string& name);
+    Gauge& GetGauge(const std::string& name);
+    Histogram& GetHistogram(const std::string& name, std::initializer_list<double> bounds);
+
+    // Appends one JSON object per interval to the given file until StopDump.
+    bool StartDump(const std::string& path, int intervalMs);
+    void StopDump();
+    std::string Snapshot() const;
+
+private:
+    Metrics() = default;
+    ~Metrics();
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    void DumpLoop(std::string path, int intervalMs);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<Counter>> counters_;
+    std::map<std::string, std::unique_ptr<Gauge>> gauges_;
+    std::map<std::string, std::unique_ptr<Histogram>> histograms_;
+
+    std::thread dumpThread_;
+    std::mutex dumpMutex_;
+    std::condition_variable dumpCondition_;
+    bool dumping_ = false;
+    std::chrono::steady_clock::time_point startTime_;
+};
@@ -1,6 +1,6 @@
 #include "Mod.hpp"
 #include <fstream>
-#include <iostream>
+#include "Log.hpp"
 
 Mod::Mod(const std::filesystem::path& modPath)
     : modPath_(modPath), priority_(0), enabled_(true) {
@@ -9,7 +9,7 @@ Mod::Mod(const std::filesystem::path& modPath)
 bool Mod::Load() {
     std::filesystem::path modInfoPath = modPath_ / "mod.json";
     if (!std::filesystem::exists(modInfoPath)) {
-        std::cerr << "Mod info file not found: " << modInfoPath << std::endl;
+        LOG_ERROR("Mod info file not found: " << modInfoPath);
         return false;
     }
 
@@ -27,7 +27,7 @@ bool Mod::Load() {
 
         return true;
     } catch (const std::exception& e) {
-        std::cerr << "Error loading mod info: " << e.what() << std::endl;
+        LOG_ERROR("Error loading mod info: " << e.what());
         return false;
     }
 } 
\ No newline at end of file
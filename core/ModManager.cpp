@@ -1,6 +1,7 @@
 #include "ModManager.hpp"
 #include <algorithm>
-#include <iostream>
+#include "Log.hpp"
+#include "Metrics.hpp"
 
 ModManager& ModManager::GetInstance() {
     static ModManager instance;
@@ -18,12 +19,14 @@ bool ModManager::Initialize(const std::filesystem::path& modsPath) {
         if (entry.is_directory()) {
             auto mod = std::make_unique<Mod>(entry.path());
             if (mod->Load()) {
-                std::cout << "Loaded mod: " << mod->GetName() << " (enabled: " << mod->IsEnabled() << ")" << std::endl;
+                LOG_INFO("Loaded mod: " << mod->GetName() << " (enabled: " << mod->IsEnabled() << ")");
                 mods_.push_back(std::move(mod));
             }
         }
     }
 
+    Metrics::GetInstance().GetGauge("mods.loaded").Set(static_cast<int64_t>(mods_.size()));
+
     std::sort(mods_.begin(), mods_.end(), 
         [](const auto& a, const auto& b) {
             return a->GetPriority() > b->GetPriority();
@@ -37,6 +40,10 @@ void ModManager::Shutdown() {
 }
 
 std::filesystem::path ModManager::ResolveAssetPath(const std::filesystem::path& originalPath) const {
+    static Counter& lookups = Metrics::GetInstance().GetCounter("mods.resolve.lookups");
+    static Counter& hits = Metrics::GetInstance().GetCounter("mods.resolve.hits");
+    lookups.Add();
+
     std::string pathStr = originalPath.string();
     
     for (const auto& mod : mods_) {
@@ -44,7 +51,8 @@ std::filesystem::path ModManager::ResolveAssetPath(const std::filesystem::path&
             std::filesystem::path modPath = mod->GetPath() / "data" / "SONICORCA" / pathStr;
             
             if (std::filesystem::exists(modPath)) {
-                std::cout << "Using mod '" << mod->GetName() << "' at: " << modPath.string() << std::endl;
+                hits.Add();
+                LOG_DEBUG("Using mod '" << mod->GetName() << "' at: " << modPath.string());
                 return modPath;
             }
         }
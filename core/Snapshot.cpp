@@ -0,0 +1,188 @@
+#include "Snapshot.hpp"
+#include <algorithm>
+#include "Log.hpp"
+
+static const uint32_t SnapshotMagic = MakeSnapshotTag('Y', 'U', 'S', 'S');
+static const uint16_t SnapshotVersion = 1;
+static const size_t SnapshotHeaderSize = sizeof(uint32_t) + sizeof(uint16_t);
+static const size_t ChunkHeaderSize = sizeof(uint32_t) + sizeof(uint16_t) + sizeof(uint32_t);
+
+SnapshotWriter::SnapshotWriter() : chunkStart_(0) {
+    Write(SnapshotMagic);
+    Write(SnapshotVersion);
+}
+
+void SnapshotWriter::WriteBytes(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    data_.insert(data_.end(), bytes, bytes + size);
+}
+
+void SnapshotWriter::WriteString(const std::string& value) {
+    Write(static_cast<uint32_t>(value.size()));
+    WriteBytes(value.data(), value.size());
+}
+
+void SnapshotWriter::BeginChunk(uint32_t tag, uint16_t version) {
+    Write(tag);
+    Write(version);
+    Write(static_cast<uint32_t>(0));
+    chunkStart_ = data_.size();
+}
+
+void SnapshotWriter::EndChunk() {
+    uint32_t size = static_cast<uint32_t>(data_.size() - chunkStart_);
+    std::memcpy(&data_[chunkStart_ - sizeof(uint32_t)], &size, sizeof(size));
+}
+
+SnapshotReader::SnapshotReader(const std::vector<uint8_t>& data)
+    : data_(data), position_(0), chunkEnd_(data.size()), valid_(false) {
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    if (!Read(magic) || !Read(version)) return;
+    if (magic != SnapshotMagic || version != SnapshotVersion) {
+        LOG_ERROR("Unsupported snapshot format (version " << version << ")");
+        return;
+    }
+    valid_ = true;
+}
+
+bool SnapshotReader::ReadBytes(void* data, size_t size) {
+    if (position_ + size > chunkEnd_) return false;
+    std::memcpy(data, data_.data() + position_, size);
+    position_ += size;
+    return true;
+}
+
+bool SnapshotReader::ReadString(std::string& value) {
+    uint32_t size = 0;
+    if (!Read(size) || position_ + size > chunkEnd_) return false;
+    value.assign(reinterpret_cast<const char*>(data_.data() + position_), size);
+    position_ += size;
+    return true;
+}
+
+bool SnapshotReader::BeginChunk(uint32_t tag, uint16_t& version) {
+    if (!valid_) return false;
+    size_t offset = SnapshotHeaderSize;
+    while (offset + ChunkHeaderSize <= data_.size()) {
+        uint32_t chunkTag, size;
+        uint16_t chunkVersion;
+        std::memcpy(&chunkTag, data_.data() + offset, sizeof(chunkTag));
+        std::memcpy(&chunkVersion, data_.data() + offset + 4, sizeof(chunkVersion));
+        std::memcpy(&size, data_.data() + offset + 6, sizeof(size));
+        offset += ChunkHeaderSize;
+        if (offset + size > data_.size()) break;
+
+        if (chunkTag == tag) {
+            version = chunkVersion;
+            position_ = offset;
+            chunkEnd_ = offset + size;
+            return true;
+        }
+        offset += size;
+    }
+    return false;
+}
+
+void SnapshotReader::EndChunk() {
+    position_ = chunkEnd_;
+    chunkEnd_ = data_.size();
+}
+
+SnapshotRing::SnapshotRing(size_t capacity, size_t keyframeInterval)
+    : capacity_(std::max<size_t>(1, capacity)), keyframeInterval_(std::max<size_t>(1, keyframeInterval)), sinceKeyframe_(0) {
+}
+
+void SnapshotRing::Push(const std::vector<uint8_t>& snapshot) {
+    Entry entry;
+    entry.size = snapshot.size();
+    entry.keyframe = entries_.empty() || sinceKeyframe_ + 1 >= keyframeInterval_;
+    if (entry.keyframe) {
+        entry.data = snapshot;
+        sinceKeyframe_ = 0;
+    } else {
+        EncodeDelta(latest_, snapshot, entry.data);
+        sinceKeyframe_++;
+    }
+    entries_.push_back(std::move(entry));
+    latest_ = snapshot;
+
+    // Deltas can't be decoded without their keyframe, so drop whole runs at once.
+    if (entries_.size() > capacity_) {
+        do {
+            entries_.pop_front();
+        } while (!entries_.empty() && !entries_.front().keyframe);
+    }
+}
+
+bool SnapshotRing::Rewind(size_t stepsBack, std::vector<uint8_t>& snapshot) {
+    if (stepsBack >= entries_.size()) return false;
+
+    size_t target = entries_.size() - 1 - stepsBack;
+    size_t keyframe = target;
+    while (!entries_[keyframe].keyframe) keyframe--;
+
+    snapshot = entries_[keyframe].data;
+    for (size_t i = keyframe + 1; i <= target; i++) {
+        ApplyDelta(entries_[i].data, entries_[i].size, snapshot);
+    }
+
+    entries_.resize(target + 1);
+    latest_ = snapshot;
+    sinceKeyframe_ = target - keyframe;
+    return true;
+}
+
+void SnapshotRing::Clear() {
+    entries_.clear();
+    latest_.clear();
+    sinceKeyframe_ = 0;
+}
+
+size_t SnapshotRing::GetMemoryUsage() const {
+    size_t total = latest_.size();
+    for (const auto& entry : entries_) total += entry.data.size();
+    return total;
+}
+
+// Delta layout: repeated [u16 unchanged bytes][u16 changed bytes][changed bytes XOR previous].
+void SnapshotRing::EncodeDelta(const std::vector<uint8_t>& previous, const std::vector<uint8_t>& current, std::vector<uint8_t>& out) {
+    auto xorAt = [&](size_t i) -> uint8_t {
+        return current[i] ^ (i < previous.size() ? previous[i] : 0);
+    };
+    auto writeU16 = [&](size_t value) {
+        uint16_t v = static_cast<uint16_t>(value);
+        out.push_back(static_cast<uint8_t>(v & 0xFF));
+        out.push_back(static_cast<uint8_t>(v >> 8));
+    };
+
+    out.clear();
+    size_t i = 0;
+    while (i < current.size()) {
+        size_t same = 0;
+        while (i + same < current.size() && same < 0xFFFF && xorAt(i + same) == 0) same++;
+        i += same;
+        size_t changed = 0;
+        while (i + changed < current.size() && changed < 0xFFFF && xorAt(i + changed) != 0) changed++;
+
+        writeU16(same);
+        writeU16(changed);
+        for (size_t k = 0; k < changed; k++) out.push_back(xorAt(i + k));
+        i += changed;
+    }
+}
+
+void SnapshotRing::ApplyDelta(const std::vector<uint8_t>& delta, size_t size, std::vector<uint8_t>& snapshot) {
+    snapshot.resize(size, 0);
+    size_t i = 0;
+    size_t offset = 0;
+    while (offset + 4 <= delta.size()) {
+        size_t same = delta[offset] | (delta[offset + 1] << 8);
+        size_t changed = delta[offset + 2] | (delta[offset + 3] << 8);
+        offset += 4;
+        i += same;
+        for (size_t k = 0; k < changed && i < size && offset < delta.size(); k++) {
+            snapshot[i++] ^= delta[offset++];
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Snapshots are a small header followed by tagged chunks. Each chunk carries its own
+// version and size so readers can skip chunks they don't know or no longer load.
+class SnapshotWriter {
+public:
+    SnapshotWriter();
+
+    template <typename T>
+    void Write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot values must be trivially copyable");
+        WriteBytes(&value, sizeof(T));
+    }
+    void WriteBytes(const void* data, size_t size);
+    void WriteString(const std::string& value);
+
+    void BeginChunk(uint32_t tag, uint16_t version);
+    void EndChunk();
+
+    const std::vector<uint8_t>& GetData() const { return data_; }
+    std::vector<uint8_t> TakeData() { return std::move(data_); }
+
+private:
+    std::vector<uint8_t> data_;
+    size_t chunkStart_;
+};
+
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const std::vector<uint8_t>& data);
+
+    bool IsValid() const { return valid_; }
+
+    template <typename T>
+    bool Read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Snapshot values must be trivially copyable");
+        return ReadBytes(&value, sizeof(T));
+    }
+    bool ReadBytes(void* data, size_t size);
+    bool ReadString(std::string& value);
+
+    // Finds a chunk by tag and limits reads to it until EndChunk.
+    bool BeginChunk(uint32_t tag, uint16_t& version);
+    void EndChunk();
+
+private:
+    const std::vector<uint8_t>& data_;
+    size_t position_;
+    size_t chunkEnd_;
+    bool valid_;
+};
+
+constexpr uint32_t MakeSnapshotTag(char a, char b, char c, char d) {
+    return static_cast<uint32_t>(a) | (static_cast<uint32_t>(b) << 8) |
+           (static_cast<uint32_t>(c) << 16) | (static_cast<uint32_t>(d) << 24);
+}
+
+// Implemented by game states and worlds that can be saved and restored.
+class Snapshottable {
+public:
+    virtual ~Snapshottable() = default;
+    virtual void SaveState(SnapshotWriter& writer) const = 0;
+    virtual bool LoadState(SnapshotReader& reader) = 0;
+};
+
+// Keeps the most recent snapshots for rewinding. Every snapshot after a keyframe is
+// stored as an XOR delta against the one before it, run-length encoded, so frames
+// where little changed cost a few bytes.
+class SnapshotRing {
+public:
+    SnapshotRing(size_t capacity, size_t keyframeInterval);
+
+    void Push(const std::vector<uint8_t>& snapshot);
+    // stepsBack = 0 is the latest snapshot. Entries newer than the restored one are dropped.
+    bool Rewind(size_t stepsBack, std::vector<uint8_t>& snapshot);
+    void Clear();
+
+    size_t GetCount() const { return entries_.size(); }
+    size_t GetMemoryUsage() const;
+
+private:
+    struct Entry {
+        std::vector<uint8_t> data;
+        size_t size;
+        bool keyframe;
+    };
+
+    static void EncodeDelta(const std::vector<uint8_t>& previous, const std::vector<uint8_t>& current, std::vector<uint8_t>& out);
+    static void ApplyDelta(const std::vector<uint8_t>& delta, size_t size, std::vector<uint8_t>& snapshot);
+
+    std::deque<Entry> entries_;
+    std::vector<uint8_t> latest_;
+    size_t capacity_;
+    size_t keyframeInterval_;
+    size_t sinceKeyframe_;
+};
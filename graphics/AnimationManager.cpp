@@ -0,0 +1,33 @@
+#include "AnimationManager.hpp"
+#include "../core/Log.hpp"
+
+AnimationManager& AnimationManager::GetInstance() {
+    static AnimationManager instance;
+    return instance;
+}
+
+const AnimationSet* AnimationManager::LoadAnimationSet(const std::string& path) {
+    auto it = sets_.find(path);
+    if (it != sets_.end()) {
+        return it->second.get();
+    }
+
+    auto set = std::make_unique<AnimationSet>();
+    if (!set->Load(path)) {
+        LOG_ERROR("Unable to load animation set " << path << "!");
+        return nullptr;
+    }
+
+    const AnimationSet* result = set.get();
+    sets_[path] = std::move(set);
+    return result;
+}
+
+void AnimationManager::UnloadAnimationSet(const std::string& path) {
+    sets_.erase(path);
+}
+
+void AnimationManager::Shutdown() {
+    sets_.clear();
+    clock_ = 0;
+}
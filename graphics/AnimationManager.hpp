@@ -0,0 +1,31 @@
+#pragma once
+
+#include "AnimationSet.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+class AnimationManager {
+public:
+    static AnimationManager& GetInstance();
+
+    const AnimationSet* LoadAnimationSet(const std::string& path);
+    void UnloadAnimationSet(const std::string& path);
+    void Shutdown();
+
+    // Shared playback clock, advanced once per frame. Objects that should animate
+    // in sync (rings, monitors, water) sample their frames from this instead of
+    // keeping their own AnimationState.
+    void Tick() { clock_++; }
+    uint32_t GetClock() const { return clock_; }
+    void SetClock(uint32_t clock) { clock_ = clock; }
+
+private:
+    AnimationManager() = default;
+    ~AnimationManager() = default;
+    AnimationManager(const AnimationManager&) = delete;
+    AnimationManager& operator=(const AnimationManager&) = delete;
+
+    std::unordered_map<std::string, std::unique_ptr<AnimationSet>> sets_;
+    uint32_t clock_ = 0;
+};
@@ -0,0 +1,159 @@
+#include "AnimationSet.hpp"
+#include "../resources/ResourceManager.hpp"
+#include "../core/JobSystem.hpp"
+#include <tinyxml2.h>
+#include "../core/Log.hpp"
+
+bool AnimationSet::Load(const std::string& path) {
+    using namespace tinyxml2;
+    std::string text = ResourceManager::GetInstance().LoadText(path);
+    if (text.empty()) return false;
+
+    XMLDocument doc;
+    if (doc.Parse(text.c_str(), text.size()) != XML_SUCCESS) {
+        LOG_ERROR("Failed to parse animation XML: " << path);
+        return false;
+    }
+    auto groupElem = doc.FirstChildElement("animationgroup");
+    if (!groupElem) return false;
+
+    auto texturesElem = groupElem->FirstChildElement("textures");
+    if (texturesElem) {
+        for (auto textureElem = texturesElem->FirstChildElement("texture"); textureElem; textureElem = textureElem->NextSiblingElement("texture")) {
+            const char* texturePath = textureElem->GetText();
+            textures_.push_back(texturePath ? ResourceManager::GetInstance().LoadTexture(texturePath) : nullptr);
+        }
+    }
+
+    for (auto animElem = groupElem->FirstChildElement("animation"); animElem; animElem = animElem->NextSiblingElement("animation")) {
+        AnimationClip clip;
+        clip.firstFrame = static_cast<uint32_t>(frames_.size());
+        clip.firstTick = static_cast<uint32_t>(tickToFrame_.size());
+        // The loop runs from loopframe through loopend (inclusive, default the last frame).
+        int loopFrame = animElem->IntAttribute("loopframe", 0);
+        int loopEnd = animElem->IntAttribute("loopend", -1);
+        uint32_t loopEndTick = 0;
+
+        for (auto frameElem = animElem->FirstChildElement("frame"); frameElem; frameElem = frameElem->NextSiblingElement("frame")) {
+            AnimationFrame frame;
+            frame.rect.x = frameElem->IntAttribute("x");
+            frame.rect.y = frameElem->IntAttribute("y");
+            frame.rect.w = frameElem->IntAttribute("w");
+            frame.rect.h = frameElem->IntAttribute("h");
+            frame.offset.x = frameElem->IntAttribute("ox");
+            frame.offset.y = frameElem->IntAttribute("oy");
+
+            int texture = frameElem->IntAttribute("texture", 0);
+            int duration = frameElem->IntAttribute("duration", 1);
+            if (texture < 0 || texture >= static_cast<int>(textures_.size())) {
+                LOG_ERROR("Animation frame references missing texture " << texture << " in " << path);
+                return false;
+            }
+            if (duration > 0xFFFF) {
+                LOG_WARNING("Animation frame duration " << duration << " in " << path << " is too long, clamping to 65535");
+                duration = 0xFFFF;
+            }
+            frame.texture = static_cast<uint16_t>(texture);
+            frame.duration = static_cast<uint16_t>(duration < 1 ? 1 : duration);
+
+            if (static_cast<int>(clip.frameCount) == loopFrame) {
+                clip.loopStartTick = clip.totalTicks;
+            }
+            uint16_t frameIndex = static_cast<uint16_t>(frames_.size());
+            tickToFrame_.insert(tickToFrame_.end(), frame.duration, frameIndex);
+            clip.totalTicks += frame.duration;
+            if (static_cast<int>(clip.frameCount) == loopEnd) {
+                loopEndTick = clip.totalTicks;
+            }
+            clip.frameCount++;
+            frames_.push_back(frame);
+        }
+
+        if (clip.frameCount == 0 || frames_.size() > 0xFFFF || clips_.size() >= InvalidClip) {
+            LOG_ERROR("Invalid animation in " << path);
+            return false;
+        }
+        if (loopEnd < 0 || loopEnd >= static_cast<int>(clip.frameCount)) {
+            loopEndTick = clip.totalTicks;
+        } else if (loopEnd < loopFrame) {
+            LOG_WARNING("Animation loopend " << loopEnd << " is before loopframe " << loopFrame << " in " << path << ", looping to the last frame");
+            loopEndTick = clip.totalTicks;
+        }
+        clip.loopTicks = (loopFrame >= 0 && loopFrame < static_cast<int>(clip.frameCount)) ? loopEndTick - clip.loopStartTick : 0;
+
+        const char* name = animElem->Attribute("name");
+        if (name) clipNames_[name] = static_cast<uint16_t>(clips_.size());
+        clips_.push_back(clip);
+    }
+
+    return !clips_.empty();
+}
+
+uint16_t AnimationSet::FindClip(const std::string& name) const {
+    auto it = clipNames_.find(name);
+    return it != clipNames_.end() ? it->second : InvalidClip;
+}
+
+uint32_t AnimationSet::WrapTick(const AnimationClip& clip, uint32_t tick) const {
+    if (clip.loopTicks == 0) return tick < clip.totalTicks ? tick : clip.totalTicks - 1;
+    uint32_t loopEndTick = clip.loopStartTick + clip.loopTicks;
+    if (tick < loopEndTick) return tick;
+    return clip.loopStartTick + (tick - clip.loopStartTick) % clip.loopTicks;
+}
+
+void AnimationSet::Play(AnimationState& state, uint16_t clip, bool restart) const {
+    if (clip >= clips_.size() || (state.clip == clip && !restart)) return;
+    state.clip = clip;
+    state.tick = 0;
+    state.frame = tickToFrame_[clips_[clip].firstTick];
+}
+
+void AnimationSet::Advance(AnimationState* states, size_t count, uint32_t ticks) const {
+    const AnimationClip* clips = clips_.data();
+    const uint16_t* table = tickToFrame_.data();
+    for (size_t i = 0; i < count; i++) {
+        AnimationState& state = states[i];
+        const AnimationClip& clip = clips[state.clip];
+        state.tick = WrapTick(clip, state.tick + ticks);
+        state.frame = table[clip.firstTick + state.tick];
+    }
+}
+
+void AnimationSet::Advance(JobSystem& jobs, AnimationState* states, size_t count, uint32_t ticks) const {
+    // States are 8 bytes, so a grain covers a few pages; smaller grains cost more in queueing than they save.
+    static const size_t ADVANCE_GRAIN = 4096;
+    if (count <= ADVANCE_GRAIN) {
+        Advance(states, count, ticks);
+        return;
+    }
+    jobs.ParallelFor(count, ADVANCE_GRAIN, [this, states, ticks](size_t begin, size_t end) {
+        Advance(states + begin, end - begin, ticks);
+    });
+}
+
+uint16_t AnimationSet::FrameAt(uint16_t clip, uint32_t tick) const {
+    const AnimationClip& c = clips_[clip];
+    return tickToFrame_[c.firstTick + WrapTick(c, tick)];
+}
+
+bool AnimationSet::IsFinished(const AnimationState& state) const {
+    const AnimationClip& clip = clips_[state.clip];
+    return clip.loopTicks == 0 && state.tick + 1 >= clip.totalTicks;
+}
+
+void AnimationSet::Render(SDL_Renderer* renderer, const AnimationState& state, int x, int y, bool flipX) const {
+    RenderFrame(renderer, state.frame, x, y, flipX);
+}
+
+void AnimationSet::RenderFrame(SDL_Renderer* renderer, uint16_t frame, int x, int y, bool flipX) const {
+    const AnimationFrame& f = frames_[frame];
+    SDL_Texture* texture = textures_[f.texture];
+    if (!texture) return;
+    int offsetX = flipX ? -(f.offset.x + f.rect.w) : f.offset.x;
+    SDL_Rect dst = { x + offsetX, y + f.offset.y, f.rect.w, f.rect.h };
+    if (flipX) {
+        SDL_RenderCopyEx(renderer, texture, &f.rect, &dst, 0.0, nullptr, SDL_FLIP_HORIZONTAL);
+    } else {
+        SDL_RenderCopy(renderer, texture, &f.rect, &dst);
+    }
+}
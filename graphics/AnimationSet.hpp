@@ -0,0 +1,75 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class JobSystem;
+
+struct AnimationFrame {
+    SDL_Rect rect;
+    SDL_Point offset = {0, 0};
+    uint16_t texture = 0;
+    uint16_t duration = 1;
+};
+
+struct AnimationClip {
+    uint32_t firstFrame = 0;
+    uint32_t frameCount = 0;
+    uint32_t firstTick = 0;     // offset into the tick -> frame table
+    uint32_t totalTicks = 0;
+    uint32_t loopStartTick = 0;
+    uint32_t loopTicks = 0;     // 0 = play once and hold the last frame; frames after the loop are never reached
+};
+
+// Per-object playback state, kept small so arrays of these can be advanced in one pass.
+struct AnimationState {
+    uint16_t clip = 0;
+    uint16_t frame = 0;         // absolute index into the set's frame table
+    uint32_t tick = 0;
+};
+
+class AnimationSet {
+public:
+    static constexpr uint16_t InvalidClip = 0xFFFF;
+
+    AnimationSet() = default;
+    ~AnimationSet() = default;
+
+    bool Load(const std::string& path);
+
+    uint16_t FindClip(const std::string& name) const;
+    size_t GetClipCount() const { return clips_.size(); }
+    const AnimationClip& GetClip(uint16_t clip) const { return clips_[clip]; }
+    const AnimationFrame& GetFrame(uint16_t frame) const { return frames_[frame]; }
+
+    // Switching to the clip already playing keeps its position unless restart is set,
+    // which also replays a finished one-shot clip.
+    void Play(AnimationState& state, uint16_t clip, bool restart = false) const;
+    void Advance(AnimationState* states, size_t count, uint32_t ticks = 1) const;
+    void Advance(std::vector<AnimationState>& states, uint32_t ticks = 1) const {
+        Advance(states.data(), states.size(), ticks);
+    }
+    // Same as Advance, split across the job system in contiguous grains.
+    void Advance(JobSystem& jobs, AnimationState* states, size_t count, uint32_t ticks = 1) const;
+    void Advance(JobSystem& jobs, std::vector<AnimationState>& states, uint32_t ticks = 1) const {
+        Advance(jobs, states.data(), states.size(), ticks);
+    }
+
+    uint16_t FrameAt(uint16_t clip, uint32_t tick) const;
+    bool IsFinished(const AnimationState& state) const;
+
+    void Render(SDL_Renderer* renderer, const AnimationState& state, int x, int y, bool flipX = false) const;
+    void RenderFrame(SDL_Renderer* renderer, uint16_t frame, int x, int y, bool flipX = false) const;
+
+private:
+    uint32_t WrapTick(const AnimationClip& clip, uint32_t tick) const;
+
+    std::vector<AnimationFrame> frames_;
+    std::vector<AnimationClip> clips_;
+    std::vector<uint16_t> tickToFrame_;
+    std::vector<SDL_Texture*> textures_;
+    std::unordered_map<std::string, uint16_t> clipNames_;
+};
@@ -1,7 +1,8 @@
 #include "BitmapFont.hpp"
 #include <SDL2/SDL_image.h>
 #include <tinyxml2.h>
-#include <iostream>
+#include "../core/Log.hpp"
+#include "../core/Metrics.hpp"
 
 BitmapFont::BitmapFont() : texture_(nullptr), charHeight_(0), tracking_(0) {}
 BitmapFont::~BitmapFont() { if (texture_) SDL_DestroyTexture(texture_); }
@@ -26,9 +27,10 @@ bool BitmapFont::Load(const std::string& xmlPath, SDL_Renderer* renderer, const
     using namespace tinyxml2;
     XMLDocument doc;
     if (doc.LoadFile(xmlPath.c_str()) != XML_SUCCESS) {
-        std::cerr << "Failed to load font XML: " << xmlPath << std::endl;
+        LOG_ERROR("Failed to load font XML: " << xmlPath);
         return false;
     }
+    Metrics::GetInstance().GetCounter("font.loads").Add();
     auto fontElem = doc.FirstChildElement("font");
     if (!fontElem) return false;
 
@@ -40,7 +42,7 @@ bool BitmapFont::Load(const std::string& xmlPath, SDL_Renderer* renderer, const
     std::string imagePath = imageDir + "/" + shapeFile + ".png";
     SDL_Surface* surf = IMG_Load(imagePath.c_str());
     if (!surf) {
-        std::cerr << "Failed to load font image: " << imagePath << std::endl;
+        LOG_ERROR("Failed to load font image: " << imagePath);
         return false;
     }
     texture_ = SDL_CreateTextureFromSurface(renderer, surf);
@@ -79,7 +81,7 @@ bool BitmapFont::LoadOverlay(const std::string& overlayImagePath, SDL_Renderer*
     }
     SDL_Surface* surf = IMG_Load(overlayImagePath.c_str());
     if (!surf) {
-        std::cerr << "Failed to load font overlay image: " << overlayImagePath << std::endl;
+        LOG_ERROR("Failed to load font overlay image: " << overlayImagePath);
         return false;
     }
     overlayTexture_ = SDL_CreateTextureFromSurface(renderer, surf);
@@ -88,6 +90,10 @@ bool BitmapFont::LoadOverlay(const std::string& overlayImagePath, SDL_Renderer*
 }
 
 void BitmapFont::RenderText(SDL_Renderer* renderer, const std::string& text, int x, int y, bool useOverlay) {
+    static Counter& glyphsDrawn = Metrics::GetInstance().GetCounter("font.glyphs_drawn");
+    static Counter& glyphsMissing = Metrics::GetInstance().GetCounter("font.glyphs_missing");
+    int drawn = 0;
+    int missing = 0;
     int cursor = x;
     for (char c : text) {
         if (c == ' ') {
@@ -95,7 +101,10 @@ void BitmapFont::RenderText(SDL_Renderer* renderer, const std::string& text, int
             continue;
         }
         auto it = chars_.find(c);
-        if (it == chars_.end()) continue;
+        if (it == chars_.end()) {
+            missing++;
+            continue;
+        }
         const FontChar& fc = it->second;
         SDL_Rect dst = { cursor + fc.offset.x, y + fc.offset.y, fc.rect.w, fc.rect.h };
         SDL_RenderCopy(renderer, texture_, &fc.rect, &dst);
@@ -103,7 +112,10 @@ void BitmapFont::RenderText(SDL_Renderer* renderer, const std::string& text, int
             SDL_RenderCopy(renderer, overlayTexture_, &fc.rect, &dst);
         }
         cursor += fc.width + tracking_;
+        drawn++;
     }
+    glyphsDrawn.Add(drawn);
+    if (missing) glyphsMissing.Add(missing);
 }
 
 int BitmapFont::GetTextWidth(const std::string& text) const {
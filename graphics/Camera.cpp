@@ -0,0 +1,66 @@
+#include "Camera.hpp"
+#include "../physics/CollisionTerrain.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Largest height change the look-ahead floor probe follows, and the slowest the view
+// moves vertically while the target is grounded.
+static const int GroundProbeDistance = 48;
+static const float GroundedSpeedY = 12.0f;
+
+Camera::Camera(int viewWidth, int viewHeight)
+    : x_(0.0f), y_(0.0f), lookAhead_(0.0f), viewWidth_(viewWidth), viewHeight_(viewHeight), bounds_{0, 0, 0, 0} {
+}
+
+void Camera::SetBounds(const CollisionTerrain& terrain) {
+    bounds_ = { 0, 0, terrain.GetWidth(), terrain.GetHeight() };
+}
+
+void Camera::SnapTo(float x, float y) {
+    x_ = x - viewWidth_ / 2.0f;
+    y_ = y - viewHeight_ / 2.0f;
+    lookAhead_ = 0.0f;
+    Clamp();
+}
+
+void Camera::Follow(float x, float y, float velocityX, float velocityY, bool grounded, const CollisionTerrain* terrain) {
+    float targetLookAhead = std::clamp(velocityX * lookAheadFactor_, -maxLookAhead_, maxLookAhead_);
+    lookAhead_ += (targetLookAhead - lookAhead_) * 0.1f;
+
+    float centerX = x_ + viewWidth_ / 2.0f;
+    float focusX = x + lookAhead_;
+    float moveX = 0.0f;
+    if (focusX > centerX + borderX_) moveX = focusX - (centerX + borderX_);
+    else if (focusX < centerX - borderX_) moveX = focusX - (centerX - borderX_);
+    x_ += std::clamp(moveX, -maxSpeed_, maxSpeed_);
+
+    float centerY = y_ + viewHeight_ / 2.0f;
+    float focusY = y;
+    float moveY = 0.0f;
+    if (grounded) {
+        if (terrain) {
+            SensorResult below = terrain->CastFloor(static_cast<int>(x), static_cast<int>(y));
+            SensorResult ahead = terrain->CastFloor(static_cast<int>(x + lookAhead_), static_cast<int>(y));
+            if (below.hit && ahead.hit && std::abs(ahead.distance - below.distance) <= GroundProbeDistance) {
+                focusY = y + (ahead.distance - below.distance);
+            }
+        }
+        float speed = std::max(GroundedSpeedY, std::fabs(velocityY));
+        moveY = std::clamp(focusY - centerY, -speed, speed);
+    } else {
+        if (focusY > centerY + borderY_) moveY = focusY - (centerY + borderY_);
+        else if (focusY < centerY - borderY_) moveY = focusY - (centerY - borderY_);
+        moveY = std::clamp(moveY, -maxSpeed_, maxSpeed_);
+    }
+    y_ += moveY;
+
+    Clamp();
+}
+
+void Camera::Clamp() {
+    if (bounds_.w <= 0 || bounds_.h <= 0) return;
+    float maxX = static_cast<float>(bounds_.x + std::max(0, bounds_.w - viewWidth_));
+    float maxY = static_cast<float>(bounds_.y + std::max(0, bounds_.h - viewHeight_));
+    x_ = std::clamp(x_, static_cast<float>(bounds_.x), maxX);
+    y_ = std::clamp(y_, static_cast<float>(bounds_.y), maxY);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+
+class CollisionTerrain;
+
+class Camera {
+public:
+    Camera(int viewWidth, int viewHeight);
+    ~Camera() = default;
+
+    void SetBounds(const SDL_Rect& bounds) { bounds_ = bounds; }
+    void SetBounds(const CollisionTerrain& terrain);
+
+    // Centres the view on a point with no smoothing, e.g. when a zone starts.
+    void SnapTo(float x, float y);
+    // Tracks a target once per tick. Horizontal look-ahead grows with speed, and
+    // while grounded the floor ahead of the target is probed so the view follows
+    // slopes without waiting for the target to leave the vertical window.
+    void Follow(float x, float y, float velocityX, float velocityY, bool grounded, const CollisionTerrain* terrain = nullptr);
+
+    int GetX() const { return static_cast<int>(x_); }
+    int GetY() const { return static_cast<int>(y_); }
+    SDL_Rect GetView() const { return { GetX(), GetY(), viewWidth_, viewHeight_ }; }
+    SDL_Point WorldToScreen(int x, int y) const { return { x - GetX(), y - GetY() }; }
+
+    void SetLookAhead(float maxDistance, float factor) { maxLookAhead_ = maxDistance; lookAheadFactor_ = factor; }
+    void SetMaxSpeed(float speed) { maxSpeed_ = speed; }
+
+private:
+    void Clamp();
+
+    float x_;
+    float y_;
+    float lookAhead_;
+    int viewWidth_;
+    int viewHeight_;
+    SDL_Rect bounds_;
+
+    float maxLookAhead_ = 128.0f;
+    float lookAheadFactor_ = 8.0f;
+    float maxSpeed_ = 32.0f;
+    float borderX_ = 32.0f;
+    float borderY_ = 64.0f;
+};
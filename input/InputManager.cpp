@@ -1,55 +1,252 @@
 #include "InputManager.hpp"
+#include <core/Snapshot.hpp>
+#include <core/Metrics.hpp>
+#include <core/Log.hpp>
+#include <nlohmann/json.hpp>
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
 
-std::unordered_set<SDL_Scancode> InputManager::currentPressedKeys;
-std::unordered_set<SDL_Scancode> InputManager::previousPressedKeys;
-
-static const SDL_Scancode trackedKeys[] = {
-    SDL_SCANCODE_Z,
-    SDL_SCANCODE_X,
-    SDL_SCANCODE_C,
-    SDL_SCANCODE_RETURN,
-    SDL_SCANCODE_UP,
-    SDL_SCANCODE_DOWN,
-    SDL_SCANCODE_LEFT,
-    SDL_SCANCODE_RIGHT
+uint32_t InputManager::currentActions = 0;
+uint32_t InputManager::previousActions = 0;
+std::bitset<SDL_NUM_SCANCODES> InputManager::currentKeys;
+std::bitset<SDL_NUM_SCANCODES> InputManager::previousKeys;
+SDL_GameController* InputManager::controller = nullptr;
+
+static constexpr InputManager::Binding Key(SDL_Scancode scancode) {
+    return { InputManager::Binding::KEYBOARD, static_cast<int16_t>(scancode), 0, 0 };
+}
+
+static constexpr InputManager::Binding Button(SDL_GameControllerButton button) {
+    return { InputManager::Binding::BUTTON, static_cast<int16_t>(button), 0, 0 };
+}
+
+static constexpr InputManager::Binding Axis(SDL_GameControllerAxis axis, int8_t direction) {
+    return { InputManager::Binding::AXIS, static_cast<int16_t>(axis), direction, InputManager::DefaultDeadzone };
+}
+
+static constexpr InputManager::BindingTable DefaultBindings = {{
+    { Key(SDL_SCANCODE_Z), Button(SDL_CONTROLLER_BUTTON_A) },
+    { Key(SDL_SCANCODE_X), Button(SDL_CONTROLLER_BUTTON_B) },
+    { Key(SDL_SCANCODE_C), Button(SDL_CONTROLLER_BUTTON_X) },
+    { Key(SDL_SCANCODE_RETURN), Button(SDL_CONTROLLER_BUTTON_START) },
+    { Key(SDL_SCANCODE_UP), Button(SDL_CONTROLLER_BUTTON_DPAD_UP), Axis(SDL_CONTROLLER_AXIS_LEFTY, -1) },
+    { Key(SDL_SCANCODE_DOWN), Button(SDL_CONTROLLER_BUTTON_DPAD_DOWN), Axis(SDL_CONTROLLER_AXIS_LEFTY, 1) },
+    { Key(SDL_SCANCODE_LEFT), Button(SDL_CONTROLLER_BUTTON_DPAD_LEFT), Axis(SDL_CONTROLLER_AXIS_LEFTX, -1) },
+    { Key(SDL_SCANCODE_RIGHT), Button(SDL_CONTROLLER_BUTTON_DPAD_RIGHT), Axis(SDL_CONTROLLER_AXIS_LEFTX, 1) }
+}};
+
+InputManager::BindingTable InputManager::bindings = DefaultBindings;
+
+// Names used for actions in the bindings config, indexed by GameKey.
+static const char* const ActionNames[InputManager::KEY_COUNT] = {
+    "Z", "X", "C", "ENTER", "UP", "DOWN", "LEFT", "RIGHT"
 };
 
 void InputManager::UpdateKeyStates() {
     const Uint8* state = SDL_GetKeyboardState(NULL);
-    previousPressedKeys = currentPressedKeys;
-    currentPressedKeys.clear();
-    for (SDL_Scancode key : trackedKeys) {
-        if (state[key]) {
-            currentPressedKeys.insert(key);
+
+    previousKeys = currentKeys;
+    for (int i = 0; i < SDL_NUM_SCANCODES; i++) {
+        currentKeys[i] = state[i] != 0;
+    }
+
+    previousActions = currentActions;
+    currentActions = 0;
+    for (int key = 0; key < KEY_COUNT; key++) {
+        for (const Binding& binding : bindings.actions[key]) {
+            if (IsBindingActive(binding, state)) {
+                currentActions |= KeyBit(static_cast<GameKey>(key));
+                break;
+            }
         }
     }
+
+    static Counter& presses = Metrics::GetInstance().GetCounter("input.presses");
+    static Gauge& held = Metrics::GetInstance().GetGauge("input.held");
+    uint32_t pressed = currentActions & ~previousActions;
+    if (pressed) presses.Add(static_cast<int64_t>(std::bitset<32>(pressed).count()));
+    held.Set(static_cast<int64_t>(std::bitset<32>(currentActions).count()));
 }
 
-bool InputManager::justPressed(SDL_Scancode key) {
-    return currentPressedKeys.find(key) != currentPressedKeys.end() &&
-           previousPressedKeys.find(key) == previousPressedKeys.end();
+bool InputManager::IsBindingActive(const Binding& binding, const Uint8* keyboard) {
+    switch (binding.type) {
+        case Binding::KEYBOARD:
+            return keyboard[binding.code] != 0;
+        case Binding::BUTTON:
+            return controller && SDL_GameControllerGetButton(controller, static_cast<SDL_GameControllerButton>(binding.code));
+        case Binding::AXIS: {
+            if (!controller) return false;
+            int value = SDL_GameControllerGetAxis(controller, static_cast<SDL_GameControllerAxis>(binding.code));
+            return value * binding.direction > binding.deadzone;
+        }
+        default:
+            return false;
+    }
 }
 
-bool InputManager::justReleased(SDL_Scancode key) {
-    return previousPressedKeys.find(key) != previousPressedKeys.end() &&
-           currentPressedKeys.find(key) == currentPressedKeys.end();
+void InputManager::HandleEvent(const SDL_Event& event) {
+    switch (event.type) {
+        case SDL_CONTROLLERDEVICEADDED:
+            if (!controller) {
+                controller = SDL_GameControllerOpen(event.cdevice.which);
+                if (controller) {
+                    LOG_INFO("Using controller: " << SDL_GameControllerName(controller));
+                }
+            }
+            break;
+        case SDL_CONTROLLERDEVICEREMOVED:
+            if (controller && SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(controller)) == event.cdevice.which) {
+                SDL_GameControllerClose(controller);
+                controller = nullptr;
+
+                // Fall back to any other controller that is still connected.
+                for (int i = 0; i < SDL_NumJoysticks() && !controller; i++) {
+                    if (SDL_IsGameController(i) && SDL_JoystickGetDeviceInstanceID(i) != event.cdevice.which) {
+                        controller = SDL_GameControllerOpen(i);
+                    }
+                }
+                if (controller) {
+                    LOG_INFO("Using controller: " << SDL_GameControllerName(controller));
+                }
+            }
+            break;
+    }
 }
 
-bool InputManager::isDown(SDL_Scancode key) {
-    return currentPressedKeys.find(key) != currentPressedKeys.end();
+void InputManager::Shutdown() {
+    if (controller) {
+        SDL_GameControllerClose(controller);
+        controller = nullptr;
+    }
 }
 
 SDL_Scancode InputManager::GetScancode(GameKey key) {
-    switch (key) {
-        case KEY_Z: return SDL_SCANCODE_Z;
-        case KEY_X: return SDL_SCANCODE_X;
-        case KEY_C: return SDL_SCANCODE_C;
-        case KEY_ENTER: return SDL_SCANCODE_RETURN;
-        case KEY_UP: return SDL_SCANCODE_UP;
-        case KEY_DOWN: return SDL_SCANCODE_DOWN;
-        case KEY_LEFT: return SDL_SCANCODE_LEFT;
-        case KEY_RIGHT: return SDL_SCANCODE_RIGHT;
-        default: return SDL_SCANCODE_UNKNOWN;
-    }
-} 
\ No newline at end of file
+    if (key < 0 || key >= KEY_COUNT) return SDL_SCANCODE_UNKNOWN;
+    for (const Binding& binding : bindings.actions[key]) {
+        if (binding.type == Binding::KEYBOARD) return static_cast<SDL_Scancode>(binding.code);
+    }
+    return SDL_SCANCODE_UNKNOWN;
+}
+
+void InputManager::ResetBindings() {
+    bindings = DefaultBindings;
+}
+
+void InputManager::SetBindings(GameKey key, const Binding* newBindings, int count) {
+    if (key < 0 || key >= KEY_COUNT) return;
+    for (int i = 0; i < MaxBindings; i++) {
+        bindings.actions[key][i] = i < count ? newBindings[i] : Binding{ Binding::NONE, 0, 0, 0 };
+    }
+}
+
+// Bindings are written as "key:<SDL key name>", "button:<SDL button name>" or
+// "axis:<SDL axis name><+|->", e.g. "key:Up", "button:dpup", "axis:lefty-".
+static bool ParseBinding(const std::string& text, int16_t deadzone, InputManager::Binding& binding) {
+    size_t colon = text.find(':');
+    if (colon == std::string::npos) return false;
+    std::string type = text.substr(0, colon);
+    std::string name = text.substr(colon + 1);
+
+    if (type == "key") {
+        SDL_Scancode scancode = SDL_GetScancodeFromName(name.c_str());
+        if (scancode == SDL_SCANCODE_UNKNOWN) return false;
+        binding = Key(scancode);
+        return true;
+    }
+    if (type == "button") {
+        SDL_GameControllerButton button = SDL_GameControllerGetButtonFromString(name.c_str());
+        if (button == SDL_CONTROLLER_BUTTON_INVALID) return false;
+        binding = Button(button);
+        return true;
+    }
+    if (type == "axis" && !name.empty() && (name.back() == '+' || name.back() == '-')) {
+        int8_t direction = name.back() == '+' ? 1 : -1;
+        name.pop_back();
+        SDL_GameControllerAxis axis = SDL_GameControllerGetAxisFromString(name.c_str());
+        if (axis == SDL_CONTROLLER_AXIS_INVALID) return false;
+        binding = Axis(axis, direction);
+        binding.deadzone = deadzone;
+        return true;
+    }
+    return false;
+}
+
+bool InputManager::LoadBindings(const std::string& path) {
+    if (!std::filesystem::exists(path)) {
+        LOG_DEBUG("No input bindings at " << path << ", using defaults");
+        return false;
+    }
+
+    try {
+        std::ifstream file(path);
+        nlohmann::json json;
+        file >> json;
+
+        int16_t deadzone = static_cast<int16_t>(std::clamp(json.value("deadzone", static_cast<int>(DefaultDeadzone)), 0, 32767));
+        const nlohmann::json& actions = json["bindings"];
+        for (int key = 0; key < KEY_COUNT; key++) {
+            if (!actions.contains(ActionNames[key])) continue;
+
+            Binding parsed[MaxBindings];
+            int count = 0;
+            for (const auto& entry : actions[ActionNames[key]]) {
+                std::string text = entry.get<std::string>();
+                if (count == MaxBindings) {
+                    LOG_WARNING("Too many bindings for " << ActionNames[key] << ", ignoring " << text);
+                } else if (ParseBinding(text, deadzone, parsed[count])) {
+                    count++;
+                } else {
+                    LOG_WARNING("Unknown input binding " << text << " for " << ActionNames[key]);
+                }
+            }
+            SetBindings(static_cast<GameKey>(key), parsed, count);
+        }
+        return true;
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error loading input bindings: " << e.what());
+        return false;
+    }
+}
+
+static const uint32_t InputChunkTag = MakeSnapshotTag('I', 'N', 'P', 'T');
+static const uint16_t InputChunkVersion = 2;
+
+static void WriteKeyBits(SnapshotWriter& writer, const std::bitset<SDL_NUM_SCANCODES>& keys) {
+    for (size_t word = 0; word < SDL_NUM_SCANCODES / 64; word++) {
+        uint64_t bits = 0;
+        for (size_t bit = 0; bit < 64; bit++) {
+            if (keys[word * 64 + bit]) bits |= uint64_t(1) << bit;
+        }
+        writer.Write(bits);
+    }
+}
+
+static bool ReadKeyBits(SnapshotReader& reader, std::bitset<SDL_NUM_SCANCODES>& keys) {
+    for (size_t word = 0; word < SDL_NUM_SCANCODES / 64; word++) {
+        uint64_t bits = 0;
+        if (!reader.Read(bits)) return false;
+        for (size_t bit = 0; bit < 64; bit++) {
+            keys[word * 64 + bit] = (bits >> bit) & 1;
+        }
+    }
+    return true;
+}
+
+void InputManager::SaveState(SnapshotWriter& writer) {
+    writer.BeginChunk(InputChunkTag, InputChunkVersion);
+    writer.Write(currentActions);
+    writer.Write(previousActions);
+    WriteKeyBits(writer, currentKeys);
+    WriteKeyBits(writer, previousKeys);
+    writer.EndChunk();
+}
+
+bool InputManager::LoadState(SnapshotReader& reader) {
+    uint16_t version = 0;
+    if (!reader.BeginChunk(InputChunkTag, version) || version != InputChunkVersion) return false;
+    bool ok = reader.Read(currentActions) && reader.Read(previousActions) &&
+              ReadKeyBits(reader, currentKeys) && ReadKeyBits(reader, previousKeys);
+    reader.EndChunk();
+    return ok;
+}
@@ -1,15 +1,15 @@
 #pragma once
 
 #include <SDL2/SDL.h>
-#include <unordered_set>
+#include <bitset>
+#include <cstdint>
+#include <string>
+
+class SnapshotWriter;
+class SnapshotReader;
 
 class InputManager {
 public:
-    static void UpdateKeyStates();
-    static bool justPressed(SDL_Scancode key);
-    static bool justReleased(SDL_Scancode key);
-    static bool isDown(SDL_Scancode key);
-
     enum GameKey {
         KEY_Z,
         KEY_X,
@@ -18,11 +18,63 @@ public:
         KEY_UP,
         KEY_DOWN,
         KEY_LEFT,
-        KEY_RIGHT
+        KEY_RIGHT,
+        KEY_COUNT
+    };
+    static_assert(KEY_COUNT <= 32, "GameKey states are packed into one 32-bit mask");
+
+    // Each GameKey is its own bit index, so every action query below is one mask test.
+    static constexpr uint32_t KeyBit(GameKey key) { return 1u << key; }
+
+    struct Binding {
+        enum Type : uint8_t {
+            NONE,
+            KEYBOARD,
+            BUTTON,
+            AXIS
+        };
+        Type type;
+        int16_t code;           // SDL_Scancode, SDL_GameControllerButton or SDL_GameControllerAxis
+        int8_t direction;       // axes only: +1 or -1
+        int16_t deadzone;       // axes only
+    };
+    static constexpr int MaxBindings = 4;
+    static constexpr int16_t DefaultDeadzone = 8000;
+
+    struct BindingTable {
+        Binding actions[KEY_COUNT][MaxBindings];
     };
+
+    static void UpdateKeyStates();
+    static void HandleEvent(const SDL_Event& event);
+    static void Shutdown();
+
+    static bool justPressed(GameKey key) { return (currentActions & ~previousActions & KeyBit(key)) != 0; }
+    static bool justReleased(GameKey key) { return (previousActions & ~currentActions & KeyBit(key)) != 0; }
+    static bool isDown(GameKey key) { return (currentActions & KeyBit(key)) != 0; }
+
+    // Raw keyboard queries, independent of bindings.
+    static bool justPressed(SDL_Scancode key) { return currentKeys[key] && !previousKeys[key]; }
+    static bool justReleased(SDL_Scancode key) { return previousKeys[key] && !currentKeys[key]; }
+    static bool isDown(SDL_Scancode key) { return currentKeys[key]; }
+
+    // First keyboard binding of an action, for code that still works in scancodes.
     static SDL_Scancode GetScancode(GameKey key);
 
+    static bool LoadBindings(const std::string& path);
+    static void ResetBindings();
+    static void SetBindings(GameKey key, const Binding* bindings, int count);
+
+    static void SaveState(SnapshotWriter& writer);
+    static bool LoadState(SnapshotReader& reader);
+
 private:
-    static std::unordered_set<SDL_Scancode> currentPressedKeys;
-    static std::unordered_set<SDL_Scancode> previousPressedKeys;
-}; 
\ No newline at end of file
+    static bool IsBindingActive(const Binding& binding, const Uint8* keyboard);
+
+    static uint32_t currentActions;
+    static uint32_t previousActions;
+    static std::bitset<SDL_NUM_SCANCODES> currentKeys;
+    static std::bitset<SDL_NUM_SCANCODES> previousKeys;
+    static BindingTable bindings;
+    static SDL_GameController* controller;
+};
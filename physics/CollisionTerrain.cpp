@@ -0,0 +1,234 @@
+#include "CollisionTerrain.hpp"
+#include <cstring>
+#include "../core/Log.hpp"
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Tile file:   "YUCT", u16 version, u16 tileCount, tileCount * (16 heights + angle)
+// Layout file: "YUCL", u16 version, u16 width, u16 height, width * height u16 cells
+static const uint16_t CollisionFileVersion = 1;
+static const uint32_t FullLane = 0xFFFF;
+
+static uint16_t ReadU16(const uint8_t* data) {
+    return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+// Lane masks are never empty when these are called.
+static int LowestBit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+static int HighestBit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanReverse(&index, mask);
+    return static_cast<int>(index);
+#else
+    return 31 - __builtin_clz(mask);
+#endif
+}
+
+static uint32_t ReverseLane(uint32_t mask) {
+    mask = ((mask & 0x5555) << 1) | ((mask >> 1) & 0x5555);
+    mask = ((mask & 0x3333) << 2) | ((mask >> 2) & 0x3333);
+    mask = ((mask & 0x0F0F) << 4) | ((mask >> 4) & 0x0F0F);
+    return ((mask & 0x00FF) << 8) | ((mask >> 8) & 0x00FF);
+}
+
+static bool CheckHeader(const std::vector<uint8_t>& data, const char* magic, size_t headerSize, const std::string& path) {
+    if (data.size() < headerSize || std::memcmp(data.data(), magic, 4) != 0) {
+        LOG_ERROR("Invalid collision file " << path << "!");
+        return false;
+    }
+    if (ReadU16(data.data() + 4) != CollisionFileVersion) {
+        LOG_ERROR("Unsupported collision file version in " << path << "!");
+        return false;
+    }
+    return true;
+}
+
+CollisionTerrain::CollisionTerrain() : layoutWidth_(0), layoutHeight_(0) {
+    tiles_.push_back(CollisionTile{});
+}
+
+bool CollisionTerrain::LoadTiles(const std::vector<uint8_t>& data, const std::string& source) {
+    if (!CheckHeader(data, "YUCT", 8, source)) return false;
+
+    uint16_t tileCount = ReadU16(data.data() + 6);
+    if (data.size() < 8 + static_cast<size_t>(tileCount) * 17 || tileCount > TileIndexMask + 1) {
+        LOG_ERROR("Truncated collision tiles in " << source << "!");
+        return false;
+    }
+
+    // Tile 0 is always the empty tile, whatever the file says.
+    tiles_.clear();
+    tiles_.push_back(CollisionTile{});
+    const uint8_t* record = data.data() + 8 + 17;
+    for (uint16_t i = 1; i < tileCount; i++, record += 17) {
+        AddTile(record, record[16]);
+    }
+    return true;
+}
+
+bool CollisionTerrain::LoadLayout(const std::vector<uint8_t>& data, const std::string& source) {
+    if (!CheckHeader(data, "YUCL", 10, source)) return false;
+
+    int width = ReadU16(data.data() + 6);
+    int height = ReadU16(data.data() + 8);
+    size_t cellCount = static_cast<size_t>(width) * height;
+    if (data.size() < 10 + cellCount * 2) {
+        LOG_ERROR("Truncated collision layout in " << source << "!");
+        return false;
+    }
+
+    std::vector<uint16_t> cells(cellCount);
+    for (size_t i = 0; i < cellCount; i++) {
+        cells[i] = ReadU16(data.data() + 10 + i * 2);
+        if ((cells[i] & TileIndexMask) >= tiles_.size()) cells[i] = 0;
+    }
+    SetLayout(width, height, std::move(cells));
+    return true;
+}
+
+uint16_t CollisionTerrain::AddTile(const uint8_t heights[16], uint8_t angle) {
+    CollisionTile tile{};
+    for (int x = 0; x < TileSize; x++) {
+        int height = heights[x] > TileSize ? TileSize : heights[x];
+        for (int y = TileSize - height; y < TileSize; y++) {
+            tile.rows[y] |= static_cast<uint16_t>(1u << x);
+            tile.columns[x] |= static_cast<uint16_t>(1u << y);
+        }
+    }
+    tile.angle = angle;
+    tiles_.push_back(tile);
+    return static_cast<uint16_t>(tiles_.size() - 1);
+}
+
+void CollisionTerrain::SetLayout(int width, int height, std::vector<uint16_t> cells) {
+    layoutWidth_ = width;
+    layoutHeight_ = height;
+    layout_ = std::move(cells);
+    layout_.resize(static_cast<size_t>(width) * height, 0);
+}
+
+uint32_t CollisionTerrain::GetLaneMask(uint16_t cell, bool vertical, int lane) const {
+    const CollisionTile& tile = tiles_[cell & TileIndexMask];
+    bool flipX = (cell & FlipX) != 0;
+    bool flipY = (cell & FlipY) != 0;
+
+    if (vertical) {
+        uint32_t mask = tile.columns[flipX ? TileSize - 1 - lane : lane];
+        return flipY ? ReverseLane(mask) : mask;
+    }
+    uint32_t mask = tile.rows[flipY ? TileSize - 1 - lane : lane];
+    return flipX ? ReverseLane(mask) : mask;
+}
+
+uint8_t CollisionTerrain::GetAngle(uint16_t cell) const {
+    uint8_t angle = tiles_[cell & TileIndexMask].angle;
+    if (cell & FlipX) angle = static_cast<uint8_t>(256 - angle);
+    if (cell & FlipY) angle = static_cast<uint8_t>(128 - angle);
+    return angle;
+}
+
+// Casts towards increasing coordinates (down for floors, right for walls). A sensor in
+// open space finds the first solid pixel at or after it, in its own tile or the next.
+// A sensor inside solid pixels finds where that solid run starts, stepping back into
+// the previous tile when the run continues across the tile edge.
+SensorResult CollisionTerrain::CastPositive(int along, int across, bool vertical) const {
+    int tile = along >> 4;
+    int local = along & 15;
+    int lane = across & 15;
+    int acrossTile = across >> 4;
+    auto cellAt = [&](int t) {
+        return vertical ? GetCell(acrossTile, t) : GetCell(t, acrossTile);
+    };
+
+    uint16_t cell = cellAt(tile);
+    uint32_t mask = GetLaneMask(cell, vertical, lane);
+    if (mask & (1u << local)) {
+        uint32_t gaps = ~mask & ((1u << local) - 1);
+        int start = gaps ? HighestBit(gaps) + 1 : 0;
+        if (start == 0) {
+            uint16_t prev = cellAt(tile - 1);
+            uint32_t prevMask = GetLaneMask(prev, vertical, lane);
+            if (prevMask & (1u << (TileSize - 1))) {
+                uint32_t prevGaps = ~prevMask & FullLane;
+                int prevStart = prevGaps ? HighestBit(prevGaps) + 1 : 0;
+                return { (tile - 1) * TileSize + prevStart - along, GetAngle(prev), true };
+            }
+        }
+        return { tile * TileSize + start - along, GetAngle(cell), true };
+    }
+    if (mask >> local) {
+        return { tile * TileSize + LowestBit(mask >> local) + local - along, GetAngle(cell), true };
+    }
+
+    uint16_t next = cellAt(tile + 1);
+    uint32_t nextMask = GetLaneMask(next, vertical, lane);
+    if (nextMask) {
+        return { (tile + 1) * TileSize + LowestBit(nextMask) - along, GetAngle(next), true };
+    }
+    return { MaxSensorDistance, 0, false };
+}
+
+SensorResult CollisionTerrain::CastNegative(int along, int across, bool vertical) const {
+    int tile = along >> 4;
+    int local = along & 15;
+    int lane = across & 15;
+    int acrossTile = across >> 4;
+    auto cellAt = [&](int t) {
+        return vertical ? GetCell(acrossTile, t) : GetCell(t, acrossTile);
+    };
+
+    uint16_t cell = cellAt(tile);
+    uint32_t mask = GetLaneMask(cell, vertical, lane);
+    if (mask & (1u << local)) {
+        uint32_t gaps = ~mask & FullLane & ~((1u << local) - 1);
+        int last = gaps ? LowestBit(gaps) - 1 : TileSize - 1;
+        if (last == TileSize - 1) {
+            uint16_t next = cellAt(tile + 1);
+            uint32_t nextMask = GetLaneMask(next, vertical, lane);
+            if (nextMask & 1u) {
+                uint32_t nextGaps = ~nextMask & FullLane;
+                int nextLast = nextGaps ? LowestBit(nextGaps) - 1 : TileSize - 1;
+                return { along - ((tile + 1) * TileSize + nextLast), GetAngle(next), true };
+            }
+        }
+        return { along - (tile * TileSize + last), GetAngle(cell), true };
+    }
+    uint32_t behind = mask & ((1u << local) - 1);
+    if (behind) {
+        return { along - (tile * TileSize + HighestBit(behind)), GetAngle(cell), true };
+    }
+
+    uint16_t prev = cellAt(tile - 1);
+    uint32_t prevMask = GetLaneMask(prev, vertical, lane);
+    if (prevMask) {
+        return { along - ((tile - 1) * TileSize + HighestBit(prevMask)), GetAngle(prev), true };
+    }
+    return { MaxSensorDistance, 0, false };
+}
+
+SensorResult CollisionTerrain::CastFloor(int x, int y) const {
+    return CastPositive(y, x, true);
+}
+
+SensorResult CollisionTerrain::CastCeiling(int x, int y) const {
+    return CastNegative(y, x, true);
+}
+
+SensorResult CollisionTerrain::CastWallRight(int x, int y) const {
+    return CastPositive(x, y, false);
+}
+
+SensorResult CollisionTerrain::CastWallLeft(int x, int y) const {
+    return CastNegative(x, y, false);
+}
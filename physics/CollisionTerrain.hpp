@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../resources/ResourceManager.hpp"
+
+// Collision mask of one 16x16 tile, built from per-column heights (solid from the bottom
+// of the tile) at load time. Bit x of rows[y] and bit y of columns[x] are both pixel (x, y),
+// so floor and wall sensors read the same pixels, gaps in a row included, without
+// rotating anything.
+struct CollisionTile {
+    uint16_t rows[16];
+    uint16_t columns[16];
+    uint8_t angle;      // 256-step angle of the surface, 0 = flat floor
+};
+
+struct SensorResult {
+    int distance;       // pixels to the first solid pixel, negative when embedded
+    uint8_t angle;
+    bool hit;
+};
+
+class CollisionTerrain {
+public:
+    static constexpr int TileSize = 16;
+    static constexpr uint16_t TileIndexMask = 0x3FFF;
+    static constexpr uint16_t FlipX = 0x4000;
+    static constexpr uint16_t FlipY = 0x8000;
+    static constexpr int MaxSensorDistance = 32;
+
+    CollisionTerrain();
+    ~CollisionTerrain() = default;
+
+    bool LoadTiles(const std::string& path) {
+        return LoadTiles(ResourceManager::GetInstance().LoadBinary(path), path);
+    }
+    bool LoadLayout(const std::string& path) {
+        return LoadLayout(ResourceManager::GetInstance().LoadBinary(path), path);
+    }
+    // The same file formats from memory; source only names the data in log messages.
+    bool LoadTiles(const std::vector<uint8_t>& data, const std::string& source);
+    bool LoadLayout(const std::vector<uint8_t>& data, const std::string& source);
+
+    uint16_t AddTile(const uint8_t heights[16], uint8_t angle);
+    void SetLayout(int width, int height, std::vector<uint16_t> cells);
+
+    int GetWidth() const { return layoutWidth_ * TileSize; }
+    int GetHeight() const { return layoutHeight_ * TileSize; }
+    size_t GetTileCount() const { return tiles_.size(); }
+
+    SensorResult CastFloor(int x, int y) const;
+    SensorResult CastCeiling(int x, int y) const;
+    SensorResult CastWallRight(int x, int y) const;
+    SensorResult CastWallLeft(int x, int y) const;
+
+private:
+    uint16_t GetCell(int tileX, int tileY) const {
+        if (tileX < 0 || tileY < 0 || tileX >= layoutWidth_ || tileY >= layoutHeight_) return 0;
+        return layout_[static_cast<size_t>(tileY) * layoutWidth_ + tileX];
+    }
+    // Solid pixels of one lane of a cell along the cast axis, flips applied: bit i is
+    // local coordinate i (y for vertical lanes, x for horizontal ones).
+    uint32_t GetLaneMask(uint16_t cell, bool vertical, int lane) const;
+    uint8_t GetAngle(uint16_t cell) const;
+    SensorResult CastPositive(int along, int across, bool vertical) const;
+    SensorResult CastNegative(int along, int across, bool vertical) const;
+
+    std::vector<CollisionTile> tiles_;
+    std::vector<uint16_t> layout_;
+    int layoutWidth_;
+    int layoutHeight_;
+};
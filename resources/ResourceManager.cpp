@@ -1,19 +1,39 @@
 #include "ResourceManager.hpp"
 #include "../core/ModManager.hpp"
-#include <iostream>
+#include "../core/Log.hpp"
+#include "../core/Metrics.hpp"
 #include <fstream>
 #include <sstream>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_mixer.h>
 #include <filesystem>
 
+struct ResourceMetrics {
+    Counter& textureHits = Metrics::GetInstance().GetCounter("resources.texture.hits");
+    Counter& textureLoads = Metrics::GetInstance().GetCounter("resources.texture.loads");
+    Counter& soundHits = Metrics::GetInstance().GetCounter("resources.sound.hits");
+    Counter& soundLoads = Metrics::GetInstance().GetCounter("resources.sound.loads");
+    Counter& fileLoads = Metrics::GetInstance().GetCounter("resources.file.loads");
+    Counter& failures = Metrics::GetInstance().GetCounter("resources.failures");
+    Gauge& texturesCached = Metrics::GetInstance().GetGauge("resources.texture.cached");
+    Gauge& soundsCached = Metrics::GetInstance().GetGauge("resources.sound.cached");
+    Histogram& textureLoadMs = Metrics::GetInstance().GetHistogram("resources.texture.load_ms", { 1, 2, 5, 10, 20, 50, 100 });
+};
+
+static ResourceMetrics& GetMetrics() {
+    static ResourceMetrics metrics;
+    return metrics;
+}
+
 ResourceManager& ResourceManager::GetInstance() {
     static ResourceManager instance;
     return instance;
 }
 
+// Static destruction order is unspecified, so the destructor must not touch Metrics;
+// GameContext calls Shutdown() while everything is still alive.
 ResourceManager::~ResourceManager() {
-    Shutdown();
+    ReleaseResources();
 }
 
 bool ResourceManager::Initialize(const std::string& dataPath) {
@@ -23,17 +43,17 @@ bool ResourceManager::Initialize(const std::string& dataPath) {
     std::filesystem::path modsPath = exePath / "mods";
     
     if (!ModManager::GetInstance().Initialize(modsPath)) {
-        std::cerr << "Failed to initialize mods!" << std::endl;
+        LOG_ERROR("Failed to initialize mods!");
         return false;
     }
     
     if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) {
-        std::cerr << "SDL_image could not initialize! SDL_image Error: " << IMG_GetError() << std::endl;
+        LOG_ERROR("SDL_image could not initialize! SDL_image Error: " << IMG_GetError());
         return false;
     }
 
     if (Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048) < 0) {
-        std::cerr << "SDL_mixer could not initialize! SDL_mixer Error: " << Mix_GetError() << std::endl;
+        LOG_ERROR("SDL_mixer could not initialize! SDL_mixer Error: " << Mix_GetError());
         return false;
     }
 
@@ -45,6 +65,12 @@ void ResourceManager::SetRenderer(SDL_Renderer* renderer) {
 }
 
 void ResourceManager::Shutdown() {
+    ReleaseResources();
+    GetMetrics().texturesCached.Set(0);
+    GetMetrics().soundsCached.Set(0);
+}
+
+void ResourceManager::ReleaseResources() {
     for (auto& pair : textureCache_) {
         SDL_DestroyTexture(pair.second);
     }
@@ -61,28 +87,19 @@ void ResourceManager::Shutdown() {
 
 SDL_Texture* ResourceManager::LoadTexture(const std::string& path) {
     if (!renderer_) {
-        std::cerr << "Renderer not set in ResourceManager!" << std::endl;
+        LOG_ERROR("Renderer not set in ResourceManager!");
         return nullptr;
     }
 
     auto it = textureCache_.find(path);
     if (it != textureCache_.end()) {
+        GetMetrics().textureHits.Add();
         return it->second;
     }
 
-    std::filesystem::path resolvedPath = ModManager::GetInstance().ResolveAssetPath(path);
-    std::string fullPath;
-    
-    if (resolvedPath.is_absolute()) {
-        fullPath = resolvedPath.string();
-    } else {
-        fullPath = dataPath_ + "/" + resolvedPath.string();
-        std::cout << "Loading: data/SONICORCA/" << path << std::endl;
-    }
-    
-    SDL_Surface* loadedSurface = IMG_Load(fullPath.c_str());
+    ScopedTimer timer(GetMetrics().textureLoadMs);
+    SDL_Surface* loadedSurface = LoadSurface(path);
     if (loadedSurface == nullptr) {
-        std::cerr << "Unable to load image " << path << "! SDL_image Error: " << IMG_GetError() << std::endl;
         return nullptr;
     }
 
@@ -90,17 +107,41 @@ SDL_Texture* ResourceManager::LoadTexture(const std::string& path) {
     SDL_FreeSurface(loadedSurface);
 
     if (texture == nullptr) {
-        std::cerr << "Unable to create texture from " << path << "! SDL Error: " << SDL_GetError() << std::endl;
+        LOG_ERROR("Unable to create texture from " << path << "! SDL Error: " << SDL_GetError());
+        GetMetrics().failures.Add();
         return nullptr;
     }
 
     textureCache_[path] = texture;
+    GetMetrics().textureLoads.Add();
+    GetMetrics().texturesCached.Set(static_cast<int64_t>(textureCache_.size()));
     return texture;
 }
 
+SDL_Surface* ResourceManager::LoadSurface(const std::string& path) {
+    std::filesystem::path resolvedPath = ModManager::GetInstance().ResolveAssetPath(path);
+    std::string fullPath;
+    
+    if (resolvedPath.is_absolute()) {
+        fullPath = resolvedPath.string();
+    } else {
+        fullPath = dataPath_ + "/" + resolvedPath.string();
+        LOG_DEBUG("Loading: data/SONICORCA/" << path);
+    }
+    
+    SDL_Surface* loadedSurface = IMG_Load(fullPath.c_str());
+    if (loadedSurface == nullptr) {
+        LOG_ERROR("Unable to load image " << path << "! SDL_image Error: " << IMG_GetError());
+        GetMetrics().failures.Add();
+        return nullptr;
+    }
+    return loadedSurface;
+}
+
 void* ResourceManager::LoadSound(const std::string& path) {
     auto it = soundCache_.find(path);
     if (it != soundCache_.end()) {
+        GetMetrics().soundHits.Add();
         return it->second;
     }
 
@@ -109,11 +150,14 @@ void* ResourceManager::LoadSound(const std::string& path) {
     
     Mix_Chunk* sound = Mix_LoadWAV(fullPath.c_str());
     if (sound == nullptr) {
-        std::cerr << "Unable to load sound " << path << "! SDL_mixer Error: " << Mix_GetError() << std::endl;
+        LOG_ERROR("Unable to load sound " << path << "! SDL_mixer Error: " << Mix_GetError());
+        GetMetrics().failures.Add();
         return nullptr;
     }
 
     soundCache_[path] = sound;
+    GetMetrics().soundLoads.Add();
+    GetMetrics().soundsCached.Set(static_cast<int64_t>(soundCache_.size()));
     return sound;
 }
 
@@ -123,20 +167,41 @@ std::string ResourceManager::LoadText(const std::string& path) {
     
     std::ifstream file(fullPath);
     if (!file.is_open()) {
-        std::cerr << "Unable to open file " << path << "!" << std::endl;
+        LOG_ERROR("Unable to open file " << path << "!");
+        GetMetrics().failures.Add();
         return "";
     }
 
+    GetMetrics().fileLoads.Add();
     std::stringstream buffer;
     buffer << file.rdbuf();
     return buffer.str();
 }
 
+std::vector<uint8_t> ResourceManager::LoadBinary(const std::string& path) {
+    std::filesystem::path resolvedPath = ModManager::GetInstance().ResolveAssetPath(path);
+    std::string fullPath = dataPath_ + "/" + resolvedPath.string();
+
+    std::ifstream file(fullPath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        LOG_ERROR("Unable to open file " << path << "!");
+        GetMetrics().failures.Add();
+        return {};
+    }
+
+    GetMetrics().fileLoads.Add();
+    std::vector<uint8_t> data(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(data.data()), data.size());
+    return data;
+}
+
 void ResourceManager::UnloadTexture(const std::string& path) {
     auto it = textureCache_.find(path);
     if (it != textureCache_.end()) {
         SDL_DestroyTexture(it->second);
         textureCache_.erase(it);
+        GetMetrics().texturesCached.Set(static_cast<int64_t>(textureCache_.size()));
     }
 }
 
@@ -145,5 +210,6 @@ void ResourceManager::UnloadSound(const std::string& path) {
     if (it != soundCache_.end()) {
         Mix_FreeChunk(static_cast<Mix_Chunk*>(it->second));
         soundCache_.erase(it);
+        GetMetrics().soundsCached.Set(static_cast<int64_t>(soundCache_.size()));
     }
 } 
\ No newline at end of file
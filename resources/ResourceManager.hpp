@@ -2,6 +2,7 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <memory>
 #include <SDL2/SDL.h>
 
@@ -11,11 +12,15 @@ public:
 
     bool Initialize(const std::string& dataPath);
     void SetRenderer(SDL_Renderer* renderer);
+    SDL_Renderer* GetRenderer() const { return renderer_; }
     void Shutdown();
 
     SDL_Texture* LoadTexture(const std::string& path);
+    // Decodes an image without touching the renderer or the cache, so it is safe to call from worker threads.
+    SDL_Surface* LoadSurface(const std::string& path);
     void* LoadSound(const std::string& path);
     std::string LoadText(const std::string& path);
+    std::vector<uint8_t> LoadBinary(const std::string& path);
 
     void UnloadTexture(const std::string& path);
     void UnloadSound(const std::string& path);
@@ -26,6 +31,8 @@ private:
     ResourceManager(const ResourceManager&) = delete;
     ResourceManager& operator=(const ResourceManager&) = delete;
 
+    void ReleaseResources();
+
     std::string dataPath_;
     SDL_Renderer* renderer_;
 
@@ -0,0 +1,320 @@
+#include "TextureStreamer.hpp"
+#include "ResourceManager.hpp"
+#include "../core/Log.hpp"
+#include "../core/Metrics.hpp"
+#include <algorithm>
+#include <nlohmann/json.hpp>
+
+// Defaults sized for a 1280x720 view: half a second of look-ahead at 60fps and
+// a quarter screen of margin around both the current and the predicted view.
+static const size_t DEFAULT_BUDGET = 256 * 1024 * 1024;
+static const float DEFAULT_LOOK_AHEAD_FRAMES = 30.0f;
+static const int DEFAULT_MARGIN = 320;
+static const int DEFAULT_UPLOADS_PER_FRAME = 2;
+
+static SDL_Rect Expand(const SDL_Rect& rect, int margin) {
+    return { rect.x - margin, rect.y - margin, rect.w + margin * 2, rect.h + margin * 2 };
+}
+
+static bool Intersects(const SDL_Rect& a, const SDL_Rect& b) {
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+static double DistanceSquared(const SDL_Rect& a, const SDL_Rect& b) {
+    double dx = (a.x + a.w / 2.0) - (b.x + b.w / 2.0);
+    double dy = (a.y + a.h / 2.0) - (b.y + b.h / 2.0);
+    return dx * dx + dy * dy;
+}
+
+static SDL_Surface* Downscale(SDL_Surface* surface, int mip) {
+    if (mip == 0) return surface;
+
+    SDL_Surface* source = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(surface);
+    if (!source) return nullptr;
+
+    SDL_Surface* scaled = SDL_CreateRGBSurfaceWithFormat(0, std::max(1, source->w >> mip), std::max(1, source->h >> mip), 32, SDL_PIXELFORMAT_RGBA32);
+    if (scaled) {
+        SDL_SetSurfaceBlendMode(source, SDL_BLENDMODE_NONE);
+        SDL_BlitScaled(source, nullptr, scaled, nullptr);
+    }
+    SDL_FreeSurface(source);
+    return scaled;
+}
+
+TextureStreamer::TextureStreamer()
+    : budget_(DEFAULT_BUDGET)
+    , residentBytes_(0)
+    , budgetGeneration_(0)
+    , stalls_(0)
+    , lookAheadFrames_(DEFAULT_LOOK_AHEAD_FRAMES)
+    , margin_(DEFAULT_MARGIN)
+    , uploadsPerFrame_(DEFAULT_UPLOADS_PER_FRAME)
+{
+    surfaceLoader_ = [](const std::string& path) { return ResourceManager::GetInstance().LoadSurface(path); };
+}
+
+TextureStreamer::~TextureStreamer() {
+    Shutdown();
+}
+
+bool TextureStreamer::LoadZone(const std::string& manifestPath) {
+    std::string text = ResourceManager::GetInstance().LoadText(manifestPath);
+    if (text.empty()) return false;
+
+    try {
+        nlohmann::json json = nlohmann::json::parse(text);
+        for (const auto& region : json["regions"]) {
+            SDL_Rect bounds = {
+                region["x"].get<int>(),
+                region["y"].get<int>(),
+                region["w"].get<int>(),
+                region["h"].get<int>()
+            };
+            AddRegion(bounds, region["textures"].get<std::vector<std::string>>(), region.value("bytes", static_cast<size_t>(0)));
+        }
+    } catch (const std::exception& e) {
+        LOG_ERROR("Error loading zone streaming manifest " << manifestPath << ": " << e.what());
+        return false;
+    }
+
+    LOG_INFO("Streaming " << regions_.size() << " regions from " << manifestPath);
+    return true;
+}
+
+void TextureStreamer::AddRegion(const SDL_Rect& bounds, std::vector<std::string> textures, size_t estimatedBytes) {
+    size_t index = regions_.size();
+    Region region;
+    region.bounds = bounds;
+    region.textures = std::move(textures);
+    region.resident.assign(region.textures.size(), nullptr);
+    region.baseBytes = estimatedBytes;
+    for (size_t i = 0; i < region.textures.size(); i++) {
+        textureIndex_[region.textures[i]].emplace_back(index, i);
+    }
+    regions_.push_back(std::move(region));
+}
+
+void TextureStreamer::Shutdown() {
+    JobSystem::GetInstance().Wait(jobs_);
+
+    for (auto& result : completed_) {
+        for (SDL_Surface* surface : result.surfaces) {
+            if (surface) SDL_FreeSurface(surface);
+        }
+    }
+    completed_.clear();
+
+    for (size_t i = 0; i < regions_.size(); i++) {
+        Evict(i);
+    }
+    regions_.clear();
+    textureIndex_.clear();
+}
+
+void TextureStreamer::Update(const SDL_Rect& view, float velocityX, float velocityY) {
+    static Counter& stalls = Metrics::GetInstance().GetCounter("streaming.stalls");
+    static Gauge& resident = Metrics::GetInstance().GetGauge("streaming.resident_bytes");
+
+    UploadCompleted();
+    PlanResidency(view, velocityX, velocityY);
+
+    for (const Region& region : regions_) {
+        if (region.residentMip < 0 && Intersects(region.bounds, view)) {
+            stalls_++;
+            stalls.Add();
+        }
+    }
+    resident.Set(static_cast<int64_t>(residentBytes_));
+}
+
+void TextureStreamer::PlanResidency(const SDL_Rect& view, float velocityX, float velocityY) {
+    SDL_Rect nearView = Expand(view, margin_);
+    SDL_Rect predicted = nearView;
+    predicted.x += static_cast<int>(velocityX * lookAheadFrames_);
+    predicted.y += static_cast<int>(velocityY * lookAheadFrames_);
+
+    std::vector<size_t> wanted;
+    for (size_t i = 0; i < regions_.size(); i++) {
+        regions_[i].targetMip = -1;
+        if (Intersects(regions_[i].bounds, nearView) || Intersects(regions_[i].bounds, predicted)) {
+            wanted.push_back(i);
+        }
+    }
+    std::sort(wanted.begin(), wanted.end(), [&](size_t a, size_t b) {
+        return DistanceSquared(regions_[a].bounds, view) < DistanceSquared(regions_[b].bounds, view);
+    });
+
+    // Start everything at full resolution, then degrade the furthest regions one mip
+    // at a time until the set fits. Anything that still doesn't fit is left out,
+    // except regions already on screen.
+    size_t total = 0;
+    for (size_t i : wanted) {
+        regions_[i].targetMip = 0;
+        total += regions_[i].baseBytes;
+    }
+    for (int mip = 1; mip <= MaxMipLevel && total > budget_; mip++) {
+        for (auto it = wanted.rbegin(); it != wanted.rend() && total > budget_; ++it) {
+            Region& region = regions_[*it];
+            total -= MipBytes(region.baseBytes, region.targetMip) - MipBytes(region.baseBytes, mip);
+            region.targetMip = mip;
+        }
+    }
+    for (auto it = wanted.rbegin(); it != wanted.rend() && total > budget_; ++it) {
+        Region& region = regions_[*it];
+        if (Intersects(region.bounds, view)) break;
+        total -= MipBytes(region.baseBytes, region.targetMip);
+        region.targetMip = -1;
+    }
+
+    // Nothing can be uploaded without a renderer, so don't decode anything either.
+    bool canUpload = ResourceManager::GetInstance().GetRenderer() != nullptr;
+    for (size_t i = 0; i < regions_.size(); i++) {
+        Region& region = regions_[i];
+        if (region.targetMip < 0) {
+            if (region.residentMip >= 0) Evict(i);
+        } else if (canUpload && region.residentMip != region.targetMip && !(region.pending && region.pendingMip == region.targetMip) &&
+                   !(region.rejectedMip == region.targetMip && region.rejectedGeneration == budgetGeneration_)) {
+            // Regions off screen that have to drop to a lower mip give their memory
+            // back now rather than when the smaller version arrives.
+            if (region.residentMip >= 0 && region.residentMip < region.targetMip && !Intersects(region.bounds, view)) {
+                Evict(i);
+            }
+            RequestLoad(i, region.targetMip);
+        }
+    }
+}
+
+void TextureStreamer::RequestLoad(size_t regionIndex, int mip) {
+    Region& region = regions_[regionIndex];
+    region.pending = true;
+    region.pendingMip = mip;
+
+    std::vector<std::string> textures = region.textures;
+    SurfaceLoader loader = surfaceLoader_;
+    JobSystem::GetInstance().Run([this, regionIndex, mip, textures, loader]() {
+        LoadResult result{ regionIndex, mip, 0, {} };
+        for (const std::string& path : textures) {
+            SDL_Surface* surface = loader(path);
+            if (surface) {
+                result.baseBytes += static_cast<size_t>(surface->w) * surface->h * 4;
+                surface = Downscale(surface, mip);
+            }
+            result.surfaces.push_back(surface);
+        }
+
+        std::lock_guard<std::mutex> lock(completedMutex_);
+        completed_.push_back(std::move(result));
+    }, &jobs_);
+}
+
+void TextureStreamer::UploadCompleted() {
+    std::vector<LoadResult> ready;
+    {
+        std::lock_guard<std::mutex> lock(completedMutex_);
+        size_t count = std::min(completed_.size(), static_cast<size_t>(std::max(1, uploadsPerFrame_)));
+        ready.assign(std::make_move_iterator(completed_.begin()), std::make_move_iterator(completed_.begin() + count));
+        completed_.erase(completed_.begin(), completed_.begin() + count);
+    }
+
+    SDL_Renderer* renderer = ResourceManager::GetInstance().GetRenderer();
+    for (LoadResult& result : ready) {
+        Region& region = regions_[result.region];
+        if (result.mip == region.pendingMip) region.pending = false;
+        region.baseBytes = result.baseBytes;
+
+        // The plan may have moved on while this was decoding. A load that doesn't fit or
+        // fails to upload is remembered so the same decode isn't requested again every frame.
+        size_t newBytes = MipBytes(result.baseBytes, result.mip);
+        bool wanted = region.targetMip == result.mip;
+        bool uploaded = false;
+        if (wanted && renderer && residentBytes_ - region.residentBytes + newBytes <= budget_) {
+            uploaded = UploadRegion(result.region, result, newBytes);
+        }
+        if (wanted && !uploaded) {
+            region.rejectedMip = result.mip;
+            region.rejectedGeneration = budgetGeneration_;
+        }
+
+        for (SDL_Surface* surface : result.surfaces) {
+            if (surface) SDL_FreeSurface(surface);
+        }
+    }
+}
+
+// The region only becomes resident if every decoded surface made it into a texture.
+// Surfaces that failed to decode were already logged and leave their slot empty.
+bool TextureStreamer::UploadRegion(size_t regionIndex, const LoadResult& result, size_t bytes) {
+    static Counter& uploads = Metrics::GetInstance().GetCounter("streaming.uploads");
+    static Counter& failures = Metrics::GetInstance().GetCounter("streaming.upload_failures");
+
+    SDL_Renderer* renderer = ResourceManager::GetInstance().GetRenderer();
+    std::vector<SDL_Texture*> textures(result.surfaces.size(), nullptr);
+    for (size_t i = 0; i < result.surfaces.size(); i++) {
+        if (!result.surfaces[i]) continue;
+        textures[i] = SDL_CreateTextureFromSurface(renderer, result.surfaces[i]);
+        if (!textures[i]) {
+            LOG_ERROR("Failed to upload streamed texture " << regions_[regionIndex].textures[i] << ": " << SDL_GetError());
+            for (SDL_Texture* texture : textures) {
+                if (texture) SDL_DestroyTexture(texture);
+            }
+            failures.Add();
+            return false;
+        }
+    }
+
+    Evict(regionIndex);
+    Region& region = regions_[regionIndex];
+    region.resident = std::move(textures);
+    region.residentMip = result.mip;
+    region.residentBytes = bytes;
+    residentBytes_ += bytes;
+    uploads.Add();
+    return true;
+}
+
+void TextureStreamer::Evict(size_t regionIndex) {
+    static Counter& evictions = Metrics::GetInstance().GetCounter("streaming.evictions");
+
+    Region& region = regions_[regionIndex];
+    if (region.residentMip < 0) return;
+    for (SDL_Texture*& texture : region.resident) {
+        if (texture) SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+    residentBytes_ -= region.residentBytes;
+    region.residentBytes = 0;
+    region.residentMip = -1;
+    budgetGeneration_++;
+    evictions.Add();
+}
+
+SDL_Texture* TextureStreamer::GetTexture(const std::string& path, int* mipLevel) const {
+    auto it = textureIndex_.find(path);
+    if (it == textureIndex_.end()) return nullptr;
+
+    SDL_Texture* best = nullptr;
+    int bestMip = -1;
+    for (const auto& entry : it->second) {
+        const Region& region = regions_[entry.first];
+        SDL_Texture* texture = region.residentMip >= 0 ? region.resident[entry.second] : nullptr;
+        if (texture && (!best || region.residentMip < bestMip)) {
+            best = texture;
+            bestMip = region.residentMip;
+        }
+    }
+    if (mipLevel) *mipLevel = bestMip;
+    return best;
+}
+
+bool TextureStreamer::RenderCopy(SDL_Renderer* renderer, const std::string& path, const SDL_Rect* src, const SDL_Rect* dst) const {
+    int mip = 0;
+    SDL_Texture* texture = GetTexture(path, &mip);
+    if (!texture) return false;
+
+    if (src && mip > 0) {
+        SDL_Rect scaled = { src->x >> mip, src->y >> mip, std::max(1, src->w >> mip), std::max(1, src->h >> mip) };
+        return SDL_RenderCopy(renderer, texture, &scaled, dst) == 0;
+    }
+    return SDL_RenderCopy(renderer, texture, src, dst) == 0;
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "../core/JobSystem.hpp"
+
+// Streams zone textures in and out by level region. Each tick the view and its velocity
+// are used to predict which regions will be on screen soon; those are decoded on job
+// workers and uploaded on the main thread, regions far behind the view are evicted,
+// and when the predicted set doesn't fit the budget the furthest regions drop to
+// lower mip levels first.
+class TextureStreamer {
+public:
+    static constexpr int MaxMipLevel = 2;
+
+    // Decodes one texture; called from job workers, so it must be thread-safe.
+    using SurfaceLoader = std::function<SDL_Surface*(const std::string& path)>;
+
+    TextureStreamer();
+    ~TextureStreamer();
+
+    bool LoadZone(const std::string& manifestPath);
+    // estimatedBytes is the mip 0 size used for budgeting until the region has been loaded once.
+    void AddRegion(const SDL_Rect& bounds, std::vector<std::string> textures, size_t estimatedBytes);
+    void Shutdown();
+
+    void SetBudget(size_t bytes) { budget_ = bytes; budgetGeneration_++; }
+    void SetLookAhead(float frames, int margin) { lookAheadFrames_ = frames; margin_ = margin; }
+    void SetUploadsPerFrame(int uploads) { uploadsPerFrame_ = uploads; }
+    // Defaults to ResourceManager::LoadSurface.
+    void SetSurfaceLoader(SurfaceLoader loader) { surfaceLoader_ = std::move(loader); }
+
+    // Main thread only: finishes pending uploads, then re-plans residency for this view.
+    void Update(const SDL_Rect& view, float velocityX, float velocityY);
+
+    // Returns nullptr when the texture isn't resident. A texture listed by several regions
+    // comes from whichever resident one has the sharpest mip. Source rects must be shifted
+    // right by mipLevel when drawing from a lower mip; RenderCopy does that.
+    SDL_Texture* GetTexture(const std::string& path, int* mipLevel = nullptr) const;
+    bool RenderCopy(SDL_Renderer* renderer, const std::string& path, const SDL_Rect* src, const SDL_Rect* dst) const;
+
+    size_t GetBudget() const { return budget_; }
+    size_t GetResidentBytes() const { return residentBytes_; }
+    size_t GetStallCount() const { return stalls_; }
+    bool IsRegionResident(size_t region) const { return regions_[region].residentMip >= 0; }
+    size_t GetRegionCount() const { return regions_.size(); }
+
+private:
+    struct Region {
+        SDL_Rect bounds;
+        std::vector<std::string> textures;
+        std::vector<SDL_Texture*> resident;
+        size_t baseBytes = 0;
+        size_t residentBytes = 0;
+        int residentMip = -1;
+        int targetMip = -1;
+        int pendingMip = -1;
+        bool pending = false;
+        // Last load thrown away for lack of budget or a failed upload; not retried
+        // until memory frees up or the budget changes.
+        int rejectedMip = -1;
+        size_t rejectedGeneration = 0;
+    };
+
+    struct LoadResult {
+        size_t region;
+        int mip;
+        size_t baseBytes;
+        std::vector<SDL_Surface*> surfaces;
+    };
+
+    static size_t MipBytes(size_t baseBytes, int mip) { return baseBytes >> (2 * mip); }
+
+    void PlanResidency(const SDL_Rect& view, float velocityX, float velocityY);
+    void RequestLoad(size_t region, int mip);
+    void UploadCompleted();
+    bool UploadRegion(size_t region, const LoadResult& result, size_t bytes);
+    void Evict(size_t region);
+
+    std::vector<Region> regions_;
+    // Path -> every (region, slot) that lists it.
+    std::unordered_map<std::string, std::vector<std::pair<size_t, size_t>>> textureIndex_;
+    SurfaceLoader surfaceLoader_;
+
+    std::mutex completedMutex_;
+    std::vector<LoadResult> completed_;
+    JobCounter jobs_;
+
+    size_t budget_;
+    size_t residentBytes_;
+    size_t budgetGeneration_;   // bumped whenever memory is freed or the budget changes
+    size_t stalls_;
+    float lookAheadFrames_;
+    int margin_;
+    int uploadsPerFrame_;
+};
@@ -0,0 +1,162 @@
+// Sensor cast tests for CollisionTerrain.
+//   g++ -std=c++17 -I. $(sdl2-config --cflags) tests/CollisionTerrainTest.cpp physics/CollisionTerrain.cpp core/Log.cpp -o collision_test
+#include "TestHarness.hpp"
+#include <physics/CollisionTerrain.hpp>
+
+static void FillHeights(uint8_t heights[16], int value) {
+    for (int x = 0; x < 16; x++) heights[x] = static_cast<uint8_t>(value);
+}
+
+TEST(FloorAboveHalfTile) {
+    CollisionTerrain terrain;
+    uint8_t heights[16];
+    FillHeights(heights, 8);
+    uint16_t half = terrain.AddTile(heights, 0);
+    terrain.SetLayout(1, 2, { 0, half });
+
+    SensorResult above = terrain.CastFloor(5, 14);
+    CHECK(above.hit);
+    CHECK_EQ(above.distance, 10);
+
+    SensorResult embedded = terrain.CastFloor(5, 27);
+    CHECK_EQ(embedded.distance, -3);
+}
+
+TEST(FloorRegressesIntoFullTileAbove) {
+    CollisionTerrain terrain;
+    uint8_t heights[16];
+    FillHeights(heights, 16);
+    uint16_t full = terrain.AddTile(heights, 0);
+    terrain.SetLayout(1, 3, { 0, full, full });
+
+    CHECK_EQ(terrain.CastFloor(5, 36).distance, -20);
+}
+
+TEST(WallOnLeftSideOfTile) {
+    // Columns 0-3 are full height: solid on the left of the tile only.
+    CollisionTerrain terrain;
+    uint8_t heights[16] = { 16, 16, 16, 16 };
+    uint16_t wall = terrain.AddTile(heights, 64);
+    terrain.SetLayout(2, 1, { 0, wall });
+
+    SensorResult right = terrain.CastWallRight(16, 8);
+    CHECK(right.hit);
+    CHECK_EQ(right.distance, 0);
+
+    SensorResult left = terrain.CastWallLeft(30, 8);
+    CHECK(left.hit);
+    CHECK_EQ(left.distance, 11);
+}
+
+TEST(WallOnFlippedTile) {
+    uint8_t heights[16] = { 16, 16, 16, 16 };
+    CollisionTerrain terrain;
+    uint16_t wall = terrain.AddTile(heights, 64);
+    terrain.SetLayout(2, 1, { 0, static_cast<uint16_t>(wall | CollisionTerrain::FlipX) });
+
+    // Flipped, the solid columns are 28-31 in world space.
+    CHECK_EQ(terrain.CastWallRight(20, 8).distance, 8);
+    CHECK_EQ(terrain.CastWallRight(30, 8).distance, -2);
+    CHECK(!terrain.CastWallLeft(26, 8).hit);
+}
+
+TEST(CeilingIgnoresSpanBelowSensor) {
+    // A 4px bump at the bottom of the tile; a sensor in the air above it must not
+    // report being embedded in it.
+    CollisionTerrain terrain;
+    uint8_t heights[16];
+    FillHeights(heights, 4);
+    uint16_t bump = terrain.AddTile(heights, 0);
+    terrain.SetLayout(2, 2, { 0, 0, 0, bump });
+
+    CHECK(!terrain.CastCeiling(24, 18).hit);
+}
+
+TEST(FloorIgnoresSpanAboveSensor) {
+    // Flipped vertically the bump hangs from the top of the tile; a floor sensor
+    // below it looks on into the next tile.
+    CollisionTerrain terrain;
+    uint8_t heights[16];
+    FillHeights(heights, 4);
+    uint16_t bump = terrain.AddTile(heights, 0);
+    FillHeights(heights, 16);
+    uint16_t full = terrain.AddTile(heights, 0);
+    terrain.SetLayout(1, 2, { static_cast<uint16_t>(bump | CollisionTerrain::FlipY), full });
+
+    SensorResult floor = terrain.CastFloor(5, 10);
+    CHECK(floor.hit);
+    CHECK_EQ(floor.distance, 6);
+}
+
+TEST(WallSensorsSeeGapsInRows) {
+    // Two one-pixel pillars at columns 0 and 15 with open space between them.
+    CollisionTerrain terrain;
+    uint8_t heights[16] = {};
+    heights[0] = 16;
+    heights[15] = 16;
+    uint16_t pillars = terrain.AddTile(heights, 0);
+    terrain.SetLayout(1, 1, { pillars });
+
+    SensorResult right = terrain.CastWallRight(8, 8);
+    CHECK(right.hit);
+    CHECK_EQ(right.distance, 7);
+
+    SensorResult left = terrain.CastWallLeft(8, 8);
+    CHECK(left.hit);
+    CHECK_EQ(left.distance, 8);
+
+    // Floor and wall sensors agree that column 8 is empty.
+    CHECK(!terrain.CastFloor(8, 2).hit);
+}
+
+TEST(FloorInsideUShapeFindsItsOwnRun) {
+    // A U shape: full-height sides, a 4px floor between them.
+    CollisionTerrain terrain;
+    uint8_t heights[16];
+    FillHeights(heights, 4);
+    heights[0] = heights[1] = heights[14] = heights[15] = 16;
+    uint16_t u = terrain.AddTile(heights, 0);
+    terrain.SetLayout(1, 1, { u });
+
+    CHECK_EQ(terrain.CastFloor(8, 2).distance, 10);
+    CHECK_EQ(terrain.CastWallRight(4, 6).distance, 10);
+    CHECK_EQ(terrain.CastWallRight(4, 13).distance, -4);
+    CHECK_EQ(terrain.CastWallLeft(12, 6).distance, 11);
+}
+
+TEST(LoadFromMemory) {
+    std::vector<uint8_t> tiles = { 'Y', 'U', 'C', 'T', 1, 0, 2, 0 };
+    tiles.insert(tiles.end(), 17, 0);
+    tiles.insert(tiles.end(), 16, 8);
+    tiles.push_back(0);
+    std::vector<uint8_t> layout = { 'Y', 'U', 'C', 'L', 1, 0, 1, 0, 2, 0, 0, 0, 1, 0 };
+
+    CollisionTerrain terrain;
+    CHECK(terrain.LoadTiles(tiles, "test tiles"));
+    CHECK(terrain.LoadLayout(layout, "test layout"));
+    CHECK_EQ(terrain.GetTileCount(), 2u);
+    CHECK_EQ(terrain.GetHeight(), 32);
+    CHECK_EQ(terrain.CastFloor(5, 14).distance, 10);
+
+    layout[4] = 2;
+    CHECK(!terrain.LoadLayout(layout, "bad version"));
+}
+
+TEST(SlopeAngleFollowsFlip) {
+    CollisionTerrain terrain;
+    uint8_t heights[16];
+    for (int x = 0; x < 16; x++) heights[x] = static_cast<uint8_t>(x + 1);
+    uint16_t slope = terrain.AddTile(heights, 224);
+    terrain.SetLayout(2, 1, { slope, static_cast<uint16_t>(slope | CollisionTerrain::FlipX) });
+
+    SensorResult normal = terrain.CastFloor(0, 0);
+    SensorResult flipped = terrain.CastFloor(31, 0);
+    CHECK_EQ(normal.distance, 15);
+    CHECK_EQ(flipped.distance, 15);
+    CHECK_EQ(normal.angle, 224);
+    CHECK_EQ(flipped.angle, 32);
+}
+
+int main() {
+    return RunTests();
+}
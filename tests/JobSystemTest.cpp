@@ -0,0 +1,74 @@
+// JobSystem tests.
+//   g++ -std=c++17 -pthread -I. tests/JobSystemTest.cpp core/JobSystem.cpp core/Log.cpp -o jobsystem_test
+#include "TestHarness.hpp"
+#include <core/JobSystem.hpp>
+#include <atomic>
+#include <vector>
+
+static const unsigned int WORKER_COUNTS[] = { 1, 2, 4, 8 };
+
+TEST(ParallelForVisitsEveryIndexOnce) {
+    for (unsigned int workers : WORKER_COUNTS) {
+        JobSystem& jobs = JobSystem::GetInstance();
+        jobs.Initialize(workers);
+        std::vector<std::atomic<int>> visits(100003);
+        jobs.ParallelFor(visits.size(), 0, [&visits](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) visits[i]++;
+        });
+        bool once = true;
+        for (auto& count : visits) once &= count.load() == 1;
+        CHECK(once);
+        jobs.Shutdown();
+    }
+}
+
+TEST(WaitCoversJobsSubmittedFromJobs) {
+    for (unsigned int workers : WORKER_COUNTS) {
+        JobSystem& jobs = JobSystem::GetInstance();
+        jobs.Initialize(workers);
+        std::atomic<int> ran{ 0 };
+        JobCounter counter;
+        for (int batch = 0; batch < 8; batch++) {
+            jobs.Run([&jobs, &ran, &counter]() {
+                for (int i = 0; i < 500; i++) {
+                    jobs.Run([&ran]() { ran++; }, &counter);
+                }
+            }, &counter);
+        }
+        jobs.Wait(counter);
+        CHECK_EQ(ran.load(), 4000);
+        CHECK(counter.IsDone());
+        jobs.Shutdown();
+    }
+}
+
+TEST(SingleWorkerRunsJobsInline) {
+    JobSystem& jobs = JobSystem::GetInstance();
+    jobs.Initialize(1);
+    bool ran = false;
+    jobs.Run([&ran]() { ran = true; });
+    CHECK(ran);
+    jobs.Shutdown();
+}
+
+TEST(NestedParallelForInsideJob) {
+    JobSystem& jobs = JobSystem::GetInstance();
+    jobs.Initialize(4);
+    std::vector<int> values(50000, 1);
+    std::atomic<long long> sum{ 0 };
+    JobCounter counter;
+    jobs.Run([&]() {
+        jobs.ParallelFor(values.size(), 1024, [&](size_t begin, size_t end) {
+            long long local = 0;
+            for (size_t i = begin; i < end; i++) local += values[i];
+            sum += local;
+        });
+    }, &counter);
+    jobs.Wait(counter);
+    CHECK_EQ(sum.load(), 50000);
+    jobs.Shutdown();
+}
+
+int main() {
+    return RunTests();
+}
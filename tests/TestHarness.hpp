@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+// Minimal test harness: each test program registers TEST cases and returns RunTests() from main.
+
+struct TestCase {
+    const char* name;
+    void (*function)();
+};
+
+inline std::vector<TestCase>& GetTestCases() {
+    static std::vector<TestCase> tests;
+    return tests;
+}
+
+inline int& GetTestFailures() {
+    static int failures = 0;
+    return failures;
+}
+
+inline bool RegisterTest(const char* name, void (*function)()) {
+    GetTestCases().push_back({ name, function });
+    return true;
+}
+
+inline int RunTests() {
+    int failedTests = 0;
+    for (const TestCase& test : GetTestCases()) {
+        int before = GetTestFailures();
+        test.function();
+        bool passed = GetTestFailures() == before;
+        if (!passed) failedTests++;
+        std::printf("[%s] %s\n", passed ? "PASS" : "FAIL", test.name);
+    }
+    std::printf("%d/%zu tests passed\n", static_cast<int>(GetTestCases().size()) - failedTests, GetTestCases().size());
+    return failedTests == 0 ? 0 : 1;
+}
+
+#define TEST(name) \
+    static void name(); \
+    static const bool name##Registered = RegisterTest(#name, name); \
+    static void name()
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            GetTestFailures()++; \
+        } \
+    } while (0)
+
+#define CHECK_EQ(actual, expected) \
+    do { \
+        auto actualValue = (actual); \
+        auto expectedValue = (expected); \
+        if (!(actualValue == expectedValue)) { \
+            std::fprintf(stderr, "%s:%d: CHECK_EQ failed: %s == %s (got %lld, expected %lld)\n", __FILE__, __LINE__, \
+                #actual, #expected, static_cast<long long>(actualValue), static_cast<long long>(expectedValue)); \
+            GetTestFailures()++; \
+        } \
+    } while (0)
@@ -0,0 +1,242 @@
+// Streaming tests for TextureStreamer: a synthetic camera path through a synthetic zone,
+// drawn with SDL's software renderer and in-memory surfaces so no data files are needed.
+// Build from the repository root with the game's other sources and libraries, e.g.
+//   g++ -std=c++17 -I. tests/TextureStreamerTest.cpp resources/TextureStreamer.cpp <engine sources> -lSDL2 -o streamer_test
+#include "TestHarness.hpp"
+#include <resources/TextureStreamer.hpp>
+#include <resources/ResourceManager.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+static const int REGION_COUNT = 64;
+static const int REGION_WIDTH = 1024;
+static const int REGION_HEIGHT = 1024;
+static const int TEXTURE_SIZE = 512;
+static const size_t TEXTURE_BYTES = static_cast<size_t>(TEXTURE_SIZE) * TEXTURE_SIZE * 4;
+static const int VIEW_WIDTH = 1280;
+static const int VIEW_HEIGHT = 720;
+static const float CAMERA_SPEED = 16.0f;
+static const int WARM_UP_FRAMES = 10;
+
+// Owns the software renderer the streamer uploads into for the length of one test.
+class SoftwareRenderer {
+public:
+    SoftwareRenderer()
+        : target_(SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_RGBA32))
+        , renderer_(target_ ? SDL_CreateSoftwareRenderer(target_) : nullptr)
+    {
+        ResourceManager::GetInstance().SetRenderer(renderer_);
+    }
+
+    ~SoftwareRenderer() {
+        ResourceManager::GetInstance().SetRenderer(nullptr);
+        if (renderer_) SDL_DestroyRenderer(renderer_);
+        if (target_) SDL_FreeSurface(target_);
+    }
+
+    bool IsValid() const { return renderer_ != nullptr; }
+
+private:
+    SDL_Surface* target_;
+    SDL_Renderer* renderer_;
+};
+
+static SDL_Surface* CreateSyntheticSurface(const std::string&) {
+    return SDL_CreateRGBSurfaceWithFormat(0, TEXTURE_SIZE, TEXTURE_SIZE, 32, SDL_PIXELFORMAT_RGBA32);
+}
+
+static void AddSyntheticZone(TextureStreamer& streamer) {
+    for (int i = 0; i < REGION_COUNT; i++) {
+        SDL_Rect bounds = { i * REGION_WIDTH, 0, REGION_WIDTH, REGION_HEIGHT };
+        std::string name = "zone/region" + std::to_string(i);
+        streamer.AddRegion(bounds, { name + "_a.png", name + "_b.png" }, TEXTURE_BYTES * 2);
+    }
+}
+
+struct CameraRun {
+    size_t peakBytes = 0;
+    bool overBudget = false;
+    size_t stallsAfterWarmUp = 0;
+};
+
+// Holds still for the warm-up, then pans right across most of the zone and back.
+static CameraRun RunCameraPath(TextureStreamer& streamer, int framesEachWay, bool waitForWorkers) {
+    CameraRun run;
+    float x = 0.0f;
+    size_t warmStalls = 0;
+    for (int frame = 0; frame < WARM_UP_FRAMES + framesEachWay * 2; frame++) {
+        float velocity = 0.0f;
+        if (frame >= WARM_UP_FRAMES) velocity = frame < WARM_UP_FRAMES + framesEachWay ? CAMERA_SPEED : -CAMERA_SPEED;
+        x += velocity;
+
+        SDL_Rect view = { static_cast<int>(x), 0, VIEW_WIDTH, VIEW_HEIGHT };
+        streamer.Update(view, velocity, 0.0f);
+        run.peakBytes = std::max(run.peakBytes, streamer.GetResidentBytes());
+        run.overBudget |= streamer.GetResidentBytes() > streamer.GetBudget();
+        if (frame == WARM_UP_FRAMES - 1) warmStalls = streamer.GetStallCount();
+        if (waitForWorkers) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    run.stallsAfterWarmUp = streamer.GetStallCount() - warmStalls;
+    return run;
+}
+
+TEST(CameraPathStaysWithinBudgetWithoutStalls) {
+    // One worker: every decode runs inline, so the run is deterministic.
+    JobSystem::GetInstance().Initialize(1);
+    {
+        SoftwareRenderer renderer;
+        CHECK(renderer.IsValid());
+
+        TextureStreamer streamer;
+        streamer.SetSurfaceLoader(CreateSyntheticSurface);
+        AddSyntheticZone(streamer);
+        // About three and a half regions at full resolution; the predicted set is larger.
+        streamer.SetBudget(TEXTURE_BYTES * 7);
+
+        CameraRun run = RunCameraPath(streamer, 1500, false);
+        CHECK(!run.overBudget);
+        CHECK(run.peakBytes > 0);
+        CHECK_EQ(run.stallsAfterWarmUp, 0u);
+
+        streamer.Shutdown();
+        CHECK_EQ(streamer.GetResidentBytes(), 0u);
+    }
+    JobSystem::GetInstance().Shutdown();
+}
+
+TEST(CameraPathWithWorkersStaysWithinBudget) {
+    JobSystem::GetInstance().Initialize(4);
+    {
+        SoftwareRenderer renderer;
+        TextureStreamer streamer;
+        streamer.SetSurfaceLoader(CreateSyntheticSurface);
+        AddSyntheticZone(streamer);
+        streamer.SetBudget(TEXTURE_BYTES * 7);
+
+        CameraRun run = RunCameraPath(streamer, 600, true);
+        CHECK(!run.overBudget);
+
+        streamer.Shutdown();
+        CHECK_EQ(streamer.GetResidentBytes(), 0u);
+    }
+    JobSystem::GetInstance().Shutdown();
+}
+
+TEST(RejectedUploadIsNotRequestedAgain) {
+    JobSystem::GetInstance().Initialize(1);
+    {
+        SoftwareRenderer renderer;
+        std::atomic<int> loads{ 0 };
+        TextureStreamer streamer;
+        streamer.SetSurfaceLoader([&loads](const std::string& path) {
+            loads++;
+            return CreateSyntheticSurface(path);
+        });
+        streamer.AddRegion({ 0, 0, REGION_WIDTH, REGION_HEIGHT }, { "zone/big.png" }, TEXTURE_BYTES);
+        // On screen regions are never dropped from the plan, but even the lowest mip doesn't fit.
+        streamer.SetBudget(1024);
+
+        SDL_Rect view = { 0, 0, VIEW_WIDTH, VIEW_HEIGHT };
+        for (int frame = 0; frame < 10; frame++) streamer.Update(view, 0.0f, 0.0f);
+        CHECK_EQ(loads.load(), 1);
+        CHECK(!streamer.IsRegionResident(0));
+
+        // Raising the budget lets it try again.
+        streamer.SetBudget(TEXTURE_BYTES);
+        for (int frame = 0; frame < 3; frame++) streamer.Update(view, 0.0f, 0.0f);
+        CHECK(streamer.IsRegionResident(0));
+        CHECK_EQ(loads.load(), 2);
+
+        streamer.Shutdown();
+    }
+    JobSystem::GetInstance().Shutdown();
+}
+
+TEST(NothingIsDecodedWithoutRenderer) {
+    JobSystem::GetInstance().Initialize(1);
+    {
+        std::atomic<int> loads{ 0 };
+        TextureStreamer streamer;
+        streamer.SetSurfaceLoader([&loads](const std::string& path) {
+            loads++;
+            return CreateSyntheticSurface(path);
+        });
+        streamer.AddRegion({ 0, 0, REGION_WIDTH, REGION_HEIGHT }, { "zone/region.png" }, TEXTURE_BYTES);
+
+        SDL_Rect view = { 0, 0, VIEW_WIDTH, VIEW_HEIGHT };
+        for (int frame = 0; frame < 10; frame++) streamer.Update(view, 0.0f, 0.0f);
+        CHECK_EQ(loads.load(), 0);
+
+        SoftwareRenderer renderer;
+        for (int frame = 0; frame < 3; frame++) streamer.Update(view, 0.0f, 0.0f);
+        CHECK(streamer.IsRegionResident(0));
+        CHECK_EQ(loads.load(), 1);
+
+        streamer.Shutdown();
+    }
+    JobSystem::GetInstance().Shutdown();
+}
+
+TEST(FailedUploadIsNotResident) {
+    JobSystem::GetInstance().Initialize(1);
+    {
+        SoftwareRenderer renderer;
+        std::atomic<int> loads{ 0 };
+        TextureStreamer streamer;
+        // The renderer refuses to create a 0x0 texture.
+        streamer.SetSurfaceLoader([&loads](const std::string& path) {
+            loads++;
+            if (path == "zone/broken.png") return SDL_CreateRGBSurfaceWithFormat(0, 0, 0, 32, SDL_PIXELFORMAT_RGBA32);
+            return CreateSyntheticSurface(path);
+        });
+        streamer.AddRegion({ 0, 0, REGION_WIDTH, REGION_HEIGHT }, { "zone/good.png", "zone/broken.png" }, TEXTURE_BYTES);
+
+        SDL_Rect view = { 0, 0, VIEW_WIDTH, VIEW_HEIGHT };
+        for (int frame = 0; frame < 10; frame++) streamer.Update(view, 0.0f, 0.0f);
+        CHECK(!streamer.IsRegionResident(0));
+        CHECK_EQ(streamer.GetResidentBytes(), 0u);
+        CHECK(streamer.GetTexture("zone/good.png") == nullptr);
+        CHECK_EQ(loads.load(), 2);
+
+        streamer.Shutdown();
+    }
+    JobSystem::GetInstance().Shutdown();
+}
+
+TEST(SharedTextureResolvesFromEveryRegion) {
+    JobSystem::GetInstance().Initialize(1);
+    {
+        SoftwareRenderer renderer;
+        TextureStreamer streamer;
+        streamer.SetSurfaceLoader(CreateSyntheticSurface);
+        streamer.AddRegion({ 0, 0, REGION_WIDTH, REGION_HEIGHT }, { "zone/shared.png", "zone/first.png" }, TEXTURE_BYTES * 2);
+        streamer.AddRegion({ REGION_WIDTH * 8, 0, REGION_WIDTH, REGION_HEIGHT }, { "zone/shared.png" }, TEXTURE_BYTES);
+        streamer.SetLookAhead(0.0f, 0);
+
+        // Only the first region is near the view; the shared texture must still resolve.
+        SDL_Rect view = { 0, 0, VIEW_WIDTH, VIEW_HEIGHT };
+        for (int frame = 0; frame < 3; frame++) streamer.Update(view, 0.0f, 0.0f);
+        CHECK(streamer.IsRegionResident(0));
+        CHECK(!streamer.IsRegionResident(1));
+        int mip = -1;
+        CHECK(streamer.GetTexture("zone/shared.png", &mip) != nullptr);
+        CHECK_EQ(mip, 0);
+
+        SDL_Rect farView = { REGION_WIDTH * 8, 0, VIEW_WIDTH, VIEW_HEIGHT };
+        for (int frame = 0; frame < 3; frame++) streamer.Update(farView, 0.0f, 0.0f);
+        CHECK(!streamer.IsRegionResident(0));
+        CHECK(streamer.IsRegionResident(1));
+        CHECK(streamer.GetTexture("zone/shared.png") != nullptr);
+        CHECK(streamer.GetTexture("zone/first.png") == nullptr);
+
+        streamer.Shutdown();
+    }
+    JobSystem::GetInstance().Shutdown();
+}
+
+int main() {
+    return RunTests();
+}